@@ -0,0 +1,136 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the haplotype coverage of a variant or hit.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace spm
+{
+    /*!\brief A dynamic bit vector storing which haplotypes cover a variant or a hit.
+     *
+     * Bit `i` is set if haplotype `i` is covered. All binary operations require both operands to have the same size.
+     */
+    class coverage
+    {
+    private:
+
+        using word_type = uint64_t;
+
+        static constexpr std::size_t word_size = 64;
+
+        std::vector<word_type> _words{};
+        std::size_t _size{};
+
+    public:
+
+        coverage() = default;
+        explicit coverage(std::size_t const size, bool const value = false) :
+            _words((size + word_size - 1) / word_size, (value) ? ~word_type{0} : word_type{0}),
+            _size{size}
+        {
+            clear_unused_bits();
+        }
+
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        constexpr bool test(std::size_t const index) const noexcept {
+            assert(index < size());
+            return (_words[index / word_size] >> (index % word_size)) & 1;
+        }
+
+        constexpr coverage & set(std::size_t const index, bool const value = true) noexcept {
+            assert(index < size());
+            word_type const mask = word_type{1} << (index % word_size);
+            if (value)
+                _words[index / word_size] |= mask;
+            else
+                _words[index / word_size] &= ~mask;
+            return *this;
+        }
+
+        //!\brief Whether any haplotype is covered.
+        constexpr bool any() const noexcept {
+            return std::ranges::any_of(_words, [] (word_type const word) { return word != 0; });
+        }
+
+        //!\brief Whether no haplotype is covered.
+        constexpr bool none() const noexcept {
+            return !any();
+        }
+
+        //!\brief The number of covered haplotypes.
+        constexpr std::size_t count() const noexcept {
+            return std::accumulate(_words.begin(), _words.end(), std::size_t{0}, [] (std::size_t sum, word_type word) {
+                return sum + std::popcount(word);
+            });
+        }
+
+        constexpr coverage & operator&=(coverage const & other) noexcept {
+            assert(size() == other.size());
+            for (std::size_t i = 0; i < _words.size(); ++i)
+                _words[i] &= other._words[i];
+            return *this;
+        }
+
+        constexpr coverage & operator|=(coverage const & other) noexcept {
+            assert(size() == other.size());
+            for (std::size_t i = 0; i < _words.size(); ++i)
+                _words[i] |= other._words[i];
+            return *this;
+        }
+
+        //!\brief Removes all haplotypes covered by `other`.
+        constexpr coverage & and_not(coverage const & other) noexcept {
+            assert(size() == other.size());
+            for (std::size_t i = 0; i < _words.size(); ++i)
+                _words[i] &= ~other._words[i];
+            return *this;
+        }
+
+        //!\brief Returns the underlying words; bits beyond size() are always zero.
+        constexpr std::vector<word_type> const & words() const noexcept {
+            return _words;
+        }
+
+    private:
+
+        constexpr void clear_unused_bits() noexcept {
+            if (std::size_t const tail = _size % word_size; tail != 0)
+                _words.back() &= (word_type{1} << tail) - 1;
+        }
+
+        friend coverage operator&(coverage lhs, coverage const & rhs) noexcept {
+            lhs &= rhs;
+            return lhs;
+        }
+
+        friend coverage operator|(coverage lhs, coverage const & rhs) noexcept {
+            lhs |= rhs;
+            return lhs;
+        }
+
+        friend bool operator==(coverage const &, coverage const &) noexcept = default;
+    };
+
+}  // namespace spm
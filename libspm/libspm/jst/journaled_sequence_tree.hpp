@@ -0,0 +1,119 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a minimal journaled sequence tree storing a reference and its haplotype variants.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+#include <libspm/jst/coverage.hpp>
+
+namespace spm
+{
+    /*!\brief A variant of the reference shared by a subset of the haplotypes.
+     *
+     * The variant replaces the reference segment `[position, position + deletion_length)` by `insertion`.
+     * A SNV has a deletion length of one and a single inserted symbol, a pure insertion has a deletion length of zero
+     * and a pure deletion has no inserted symbols.
+     */
+    template <typename alphabet_t>
+    struct sequence_variant
+    {
+        std::size_t position{}; //!< The reference position of the variant.
+        std::size_t deletion_length{}; //!< The number of deleted reference symbols.
+        std::vector<alphabet_t> insertion{}; //!< The inserted symbols.
+        spm::coverage coverage{}; //!< The haplotypes carrying the variant.
+    };
+
+    namespace detail
+    {
+        // Variants are ordered by position; at the same position insertions precede replacements and deletions.
+        template <typename variant_t>
+        constexpr auto variant_order_key(variant_t const & variant) noexcept {
+            return std::tuple{variant.position, variant.deletion_length};
+        }
+    } // namespace detail
+
+    //!\brief Models a variant that can be traversed by spm::jst_search.
+    template <typename variant_t>
+    concept traversable_variant = requires (variant_t const & variant)
+    {
+        { variant.position } -> std::convertible_to<std::size_t>;
+        { variant.deletion_length } -> std::convertible_to<std::size_t>;
+        requires std::ranges::random_access_range<decltype((variant.insertion))>;
+        { variant.coverage } -> std::convertible_to<spm::coverage const &>;
+    };
+
+    //!\brief Models a sequence tree consisting of a reference and its variants sorted by position.
+    template <typename tree_t>
+    concept sequence_tree = requires (tree_t const & tree)
+    {
+        requires std::ranges::random_access_range<decltype(tree.reference())>;
+        requires std::ranges::random_access_range<decltype(tree.variants())>;
+        requires traversable_variant<std::ranges::range_value_t<decltype(tree.variants())>>;
+        { tree.haplotype_count() } -> std::convertible_to<std::size_t>;
+    };
+
+    /*!\brief Stores a reference sequence and the variants of a set of haplotypes.
+     *
+     * The variants are kept sorted by their position such that they can be traversed by spm::jst_search.
+     * The haplotypes are never materialised.
+     */
+    template <typename alphabet_t>
+    class journaled_sequence_tree
+    {
+    public:
+
+        using variant_type = sequence_variant<alphabet_t>;
+
+    private:
+
+        std::vector<alphabet_t> _reference{};
+        std::vector<variant_type> _variants{};
+        std::size_t _haplotype_count{};
+
+    public:
+
+        journaled_sequence_tree() = default;
+        explicit journaled_sequence_tree(std::vector<alphabet_t> reference, std::size_t const haplotype_count) :
+            _reference{std::move(reference)},
+            _haplotype_count{haplotype_count}
+        {}
+
+        //!\brief Inserts a variant while keeping the variants sorted.
+        void insert(variant_type variant) {
+            assert(variant.position + variant.deletion_length <= _reference.size());
+            assert(variant.coverage.size() == _haplotype_count);
+
+            auto it = std::ranges::upper_bound(_variants, detail::variant_order_key(variant), std::ranges::less{},
+                                               [] (variant_type const & v) { return detail::variant_order_key(v); });
+            _variants.insert(it, std::move(variant));
+        }
+
+        constexpr std::vector<alphabet_t> const & reference() const noexcept {
+            return _reference;
+        }
+
+        constexpr std::vector<variant_type> const & variants() const noexcept {
+            return _variants;
+        }
+
+        constexpr std::size_t haplotype_count() const noexcept {
+            return _haplotype_count;
+        }
+    };
+
+}  // namespace spm
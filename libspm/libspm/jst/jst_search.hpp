@@ -0,0 +1,433 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the traversal of a journaled sequence tree with a restorable matcher.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libspm/jst/coverage.hpp>
+#include <libspm/jst/journaled_sequence_tree.hpp>
+#include <libspm/matcher/concept.hpp>
+
+namespace spm
+{
+    //!\brief A hit found by spm::jst_search.
+    struct jst_hit
+    {
+        //!\brief Denotes a hit on the reference path.
+        static constexpr std::ptrdiff_t reference_path = -1;
+
+        /*!\brief The end position (exclusive) of the hit in the coordinates of the traversed path.
+         *
+         * Up to the branch position, the path coordinates are the reference coordinates. Inside a branch every
+         * symbol of the branch, including the inserted ones, advances the position by one.
+         */
+        std::size_t end_position{};
+        std::ptrdiff_t branch_variant{reference_path}; //!< Index of the variant opening the branch.
+
+    private:
+
+        constexpr friend bool operator==(jst_hit const &, jst_hit const &) noexcept = default;
+    };
+
+    namespace detail
+    {
+        /*!\brief Traverses a reference and a sorted range of variants depth-first with a restorable matcher.
+         *
+         * The reference is scanned once. At every variant the state of the matcher is captured, the branch containing
+         * the alternative allele is searched and afterwards the state is restored to continue on the reference.
+         * A branch is followed only as long as a hit can still overlap the variant opening it, i.e. for
+         * `window_size(matcher) - 1` symbols after the variant. Variants within this context open nested branches.
+         * Every hit is reported exactly once together with the haplotypes that contain it at this location.
+         *
+         * The variants are pulled from an input range and buffered only as long as they can affect a hit.
+         */
+        template <std::ranges::random_access_range reference_t,
+                  std::ranges::input_range variants_t,
+                  restorable_matcher matcher_t,
+                  typename callback_t>
+        class jst_traverser
+        {
+        private:
+
+            using variant_type = std::ranges::range_value_t<variants_t>;
+            using variant_reference_t = std::ranges::range_reference_t<variants_t>;
+            // Keep references to variants if the range owns them, otherwise store a copy.
+            static constexpr bool buffer_references = std::ranges::forward_range<variants_t> &&
+                                                      std::is_lvalue_reference_v<variant_reference_t>;
+            using buffered_variant_type = std::conditional_t<buffer_references,
+                                                             std::reference_wrapper<variant_type const>,
+                                                             variant_type>;
+            using reference_iterator_t = std::ranges::iterator_t<reference_t const>;
+
+            reference_t const & _reference;
+            std::ranges::iterator_t<variants_t> _variant_it;
+            std::ranges::sentinel_t<variants_t> _variant_end;
+            matcher_t & _matcher;
+            callback_t & _callback;
+
+            std::size_t _window_size{};
+            std::size_t _haplotype_count{};
+
+            std::deque<buffered_variant_type> _buffer{};
+            std::ptrdiff_t _buffer_offset{}; // global index of the first buffered variant.
+            std::vector<spm::coverage> _branch_coverage{}; // one coverage per nesting depth.
+            spm::coverage _hit_coverage{};
+
+        public:
+
+            jst_traverser(reference_t const & reference,
+                          variants_t & variants,
+                          std::size_t const haplotype_count,
+                          matcher_t & matcher,
+                          callback_t & callback,
+                          std::ptrdiff_t const first_variant_index = 0) :
+                _reference{reference},
+                _variant_it{std::ranges::begin(variants)},
+                _variant_end{std::ranges::end(variants)},
+                _matcher{matcher},
+                _callback{callback},
+                _window_size{spm::window_size(matcher)},
+                _haplotype_count{haplotype_count},
+                _buffer_offset{first_variant_index},
+                _hit_coverage(haplotype_count)
+            {}
+
+            void operator()() {
+                (*this)(0, std::ranges::size(_reference));
+            }
+
+            /*!\brief Traverses only the bin `[begin, end)` of the reference.
+             *
+             * Reports the hits on the reference path ending in `(begin, end]` and the hits in the branches of all
+             * variants starting in `[begin, end)`. If `end` is the size of the reference, the insertions appended to the
+             * reference belong to the bin as well. Before the bin, the matcher is fed with `window_size - 1` symbols of
+             * the reference and the preceding variants are buffered without opening their branches. Hence, traversing
+             * adjacent bins with independent matchers reports the same hits in the same order as the full traversal.
+             */
+            void operator()(std::size_t const begin, std::size_t const end) {
+                std::size_t const reference_size = std::ranges::size(_reference);
+                assert(begin <= end && end <= reference_size);
+
+                if (_window_size == 0)
+                    return;
+
+                std::size_t const context_begin = begin - std::min(begin, _window_size - 1);
+                search_chunk(reference_segment(context_begin, begin), context_begin, [] (std::size_t) {});
+
+                std::size_t reference_position{begin};
+                std::size_t next_index{}; // buffer index of the next variant to branch from.
+                while ((next_index < _buffer.size() || fetch_next()) && variant(next_index).position < begin)
+                    ++next_index;
+
+                while (true) {
+                    if (next_index == _buffer.size() && !fetch_next())
+                        break;
+
+                    std::size_t const branch_position = variant(next_index).position;
+                    assert(branch_position >= reference_position); // variants must be sorted.
+                    if (branch_position >= end && end < reference_size)
+                        break;
+
+                    search_reference(reference_position, branch_position);
+                    reference_position = branch_position;
+
+                    for (; next_index < _buffer.size() || fetch_next(); ++next_index) {
+                        if (variant(next_index).position != branch_position)
+                            break;
+
+                        search_branch(next_index);
+                    }
+
+                    next_index -= release(reference_position, next_index);
+                }
+
+                search_reference(reference_position, end);
+            }
+
+        private:
+
+            // ----------------------------------------------------------------------------
+            // Reference path
+            // ----------------------------------------------------------------------------
+
+            void search_reference(std::size_t const begin, std::size_t const end) {
+                if (begin == end)
+                    return;
+
+                search_chunk(reference_segment(begin, end), begin, [&] (std::size_t const end_position) {
+                    // All haplotypes not having a variant overlapping the hit.
+                    _hit_coverage = spm::coverage(_haplotype_count, true);
+                    for (std::size_t i = 0; i < _buffer.size(); ++i) {
+                        variant_type const & other = variant(i);
+                        if (other.position < end_position && overlaps_window(other, end_position))
+                            _hit_coverage.and_not(other.coverage);
+                    }
+                    report(jst_hit{.end_position = end_position});
+                });
+            }
+
+            // ----------------------------------------------------------------------------
+            // Branches
+            // ----------------------------------------------------------------------------
+
+            void search_branch(std::size_t const root_index) {
+                variant_type const & root = variant(root_index);
+                if (root.coverage.none())
+                    return;
+
+                auto const state = capture_state();
+
+                reserve_depth(0);
+                coverage_at(0) = root.coverage;
+                std::ptrdiff_t const branch_index = global_index(root_index);
+                auto on_hit = [&] (std::size_t const end_position, std::size_t const depth) {
+                    _hit_coverage = coverage_at(depth);
+                    // Remove haplotypes with a variant preceding the branch but still overlapping the hit.
+                    for (std::size_t i = 0; i < root_index; ++i) {
+                        variant_type const & other = variant(i);
+                        if (overlaps_window(other, end_position))
+                            _hit_coverage.and_not(other.coverage);
+                    }
+                    report(jst_hit{.end_position = end_position, .branch_variant = branch_index});
+                };
+
+                std::size_t const insertion_size = std::ranges::size(root.insertion);
+                search_chunk(root.insertion, root.position, [&] (std::size_t const end_position) {
+                    on_hit(end_position, 0);
+                });
+
+                search_context(root.position + root.deletion_length,
+                               root.position + insertion_size,
+                               _window_size - 1,
+                               root_index + 1,
+                               0,
+                               on_hit);
+
+                spm::restore(_matcher, state);
+            }
+
+            template <typename on_hit_t>
+            void search_context(std::size_t reference_position,
+                                std::size_t path_position,
+                                std::size_t budget,
+                                std::size_t next_index,
+                                std::size_t const depth,
+                                on_hit_t & on_hit) {
+                std::size_t const reference_size = std::ranges::size(_reference);
+                reserve_depth(depth + 1);
+
+                while (budget > 0) {
+                    fetch_until(reference_position + budget);
+
+                    // Skip variants overlapping with the already taken alternatives.
+                    while (next_index < _buffer.size() && variant(next_index).position < reference_position)
+                        ++next_index;
+
+                    std::size_t chunk_end = std::min(reference_position + budget, reference_size);
+                    if (next_index < _buffer.size())
+                        chunk_end = std::min(chunk_end, variant(next_index).position);
+
+                    std::size_t const chunk_size = chunk_end - reference_position;
+                    if (chunk_size > 0) {
+                        search_chunk(reference_segment(reference_position, chunk_end), path_position,
+                                     [&] (std::size_t const end_position) { on_hit(end_position, depth); });
+                        reference_position = chunk_end;
+                        path_position += chunk_size;
+                        budget -= chunk_size;
+                        continue;
+                    }
+
+                    if (next_index == _buffer.size() || variant(next_index).position != reference_position)
+                        return; // reached the end of the reference.
+
+                    // Every variant at the current position opens a nested branch.
+                    for (; next_index < _buffer.size() && variant(next_index).position == reference_position;
+                         ++next_index) {
+                        variant_type const & nested = variant(next_index);
+                        coverage_at(depth + 1) = coverage_at(depth);
+                        coverage_at(depth + 1) &= nested.coverage;
+
+                        if (coverage_at(depth + 1).any()) {
+                            auto const state = capture_state();
+
+                            std::size_t const insertion_size = std::min(budget, std::ranges::size(nested.insertion));
+                            auto const insertion_begin = std::ranges::begin(nested.insertion);
+                            search_chunk(std::ranges::subrange{insertion_begin, insertion_begin + insertion_size},
+                                         path_position,
+                                         [&] (std::size_t const end_position) { on_hit(end_position, depth + 1); });
+
+                            search_context(reference_position + nested.deletion_length,
+                                           path_position + insertion_size,
+                                           budget - insertion_size,
+                                           next_index + 1,
+                                           depth + 1,
+                                           on_hit);
+
+                            spm::restore(_matcher, state);
+                        }
+
+                        // The remaining path continues without the nested variant.
+                        coverage_at(depth).and_not(nested.coverage);
+                        if (coverage_at(depth).none())
+                            return;
+                    }
+                }
+            }
+
+            // ----------------------------------------------------------------------------
+            // Helper
+            // ----------------------------------------------------------------------------
+
+            template <std::ranges::random_access_range haystack_t, typename on_hit_t>
+            void search_chunk(haystack_t && haystack, std::size_t const path_offset, on_hit_t && on_hit) {
+                if (std::ranges::empty(haystack))
+                    return;
+
+                _matcher(std::views::all((haystack_t &&) haystack), path_offset, [&] (auto const & hit) {
+                    on_hit(hit.end_position);
+                });
+            }
+
+            void report(jst_hit const & hit) {
+                if (_hit_coverage.any())
+                    _callback(hit, std::as_const(_hit_coverage));
+            }
+
+            // A variant overlaps the window of a hit if it affects one of the last window_size symbols before the
+            // end position. A pure insertion affects the window if the window spans the insertion point.
+            constexpr bool overlaps_window(variant_type const & other, std::size_t const end_position) const noexcept {
+                return end_position < other.position + other.deletion_length + _window_size;
+            }
+
+            auto reference_segment(std::size_t const begin, std::size_t const end) const noexcept {
+                reference_iterator_t reference_begin = std::ranges::begin(_reference);
+                return std::ranges::subrange{reference_begin + begin, reference_begin + end};
+            }
+
+            auto capture_state() const {
+                return matcher_state_t<matcher_t>{spm::capture(_matcher)};
+            }
+
+            spm::coverage & coverage_at(std::size_t const depth) noexcept {
+                assert(depth < _branch_coverage.size());
+                return _branch_coverage[depth];
+            }
+
+            // Allocates the coverages up to the given depth before any of them is referenced.
+            void reserve_depth(std::size_t const depth) {
+                if (depth >= _branch_coverage.size())
+                    _branch_coverage.resize(depth + 1);
+            }
+
+            // ----------------------------------------------------------------------------
+            // Variant buffer
+            // ----------------------------------------------------------------------------
+
+            constexpr variant_type const & variant(std::size_t const index) const noexcept {
+                assert(index < _buffer.size());
+                if constexpr (buffer_references)
+                    return _buffer[index].get();
+                else
+                    return _buffer[index];
+            }
+
+            constexpr std::ptrdiff_t global_index(std::size_t const index) const noexcept {
+                return _buffer_offset + static_cast<std::ptrdiff_t>(index);
+            }
+
+            bool fetch_next() {
+                if (_variant_it == _variant_end)
+                    return false;
+
+                if constexpr (buffer_references)
+                    _buffer.emplace_back(std::cref(*_variant_it));
+                else
+                    _buffer.emplace_back(*_variant_it);
+
+                assert(_buffer.size() < 2 ||
+                       variant_order_key(variant(_buffer.size() - 2)) <= variant_order_key(variant(_buffer.size() - 1)));
+                ++_variant_it;
+                return true;
+            }
+
+            // Buffers all variants starting before the given position.
+            void fetch_until(std::size_t const position) {
+                while ((_buffer.empty() || variant(_buffer.size() - 1).position < position) && fetch_next())
+                {}
+            }
+
+            // Releases all variants that already opened their branch and can no longer overlap a hit.
+            std::size_t release(std::size_t const reference_position, std::size_t const next_index) {
+                std::size_t released{};
+                while (released < next_index) {
+                    variant_type const & front = variant(0);
+                    if (front.position + front.deletion_length + _window_size > reference_position)
+                        break;
+
+                    _buffer.pop_front();
+                    ++_buffer_offset;
+                    ++released;
+                }
+                return released;
+            }
+        };
+    } // namespace detail
+
+    /*!\brief Searches all haplotypes described by a reference and a stream of variants with a single traversal.
+     * \param reference The reference sequence.
+     * \param variants An input range over the variants sorted by position.
+     * \param haplotype_count The number of haplotypes, i.e. the size of the coverage of every variant.
+     * \param matcher The restorable matcher used to search the haplotypes.
+     * \param callback The callback invoked with the spm::jst_hit and the spm::coverage of every hit.
+     *
+     * The variants are consumed in a single pass and only buffered as long as they can affect a hit.
+     * Hence, they can be read lazily, e.g. from a file.
+     */
+    template <std::ranges::random_access_range reference_t,
+              std::ranges::input_range variants_t,
+              restorable_matcher matcher_t,
+              typename callback_t>
+        requires traversable_variant<std::ranges::range_value_t<variants_t>>
+    void jst_search(reference_t const & reference,
+                    variants_t && variants,
+                    std::size_t const haplotype_count,
+                    matcher_t & matcher,
+                    callback_t && callback) {
+        detail::jst_traverser traverser{reference, variants, haplotype_count, matcher, callback};
+        traverser();
+    }
+
+    /*!\brief Searches all haplotypes of a sequence tree with a single traversal.
+     * \param tree The sequence tree modelling spm::sequence_tree.
+     * \param matcher The restorable matcher used to search the tree.
+     * \param callback The callback invoked with the spm::jst_hit and the spm::coverage of every hit.
+     *
+     * The reference is scanned once and every variant opens a branch that is searched for
+     * `window_size(matcher) - 1` symbols after the variant. The matcher state is captured before and restored after
+     * each branch. The coverage passed to the callback contains all haplotypes having the hit at the reported location
+     * and is only valid during the invocation of the callback.
+     */
+    template <sequence_tree tree_t, restorable_matcher matcher_t, typename callback_t>
+    void jst_search(tree_t const & tree, matcher_t & matcher, callback_t && callback) {
+        spm::jst_search(tree.reference(), tree.variants(), tree.haplotype_count(), matcher, (callback_t &&) callback);
+    }
+
+}  // namespace spm
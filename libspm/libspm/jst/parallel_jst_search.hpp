@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the parallel traversal of a journaled sequence tree partitioned into reference bins.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libspm/jst/coverage.hpp>
+#include <libspm/jst/journaled_sequence_tree.hpp>
+#include <libspm/jst/jst_search.hpp>
+#include <libspm/matcher/concept.hpp>
+
+namespace spm
+{
+    namespace detail
+    {
+        /*!\brief Partitions the reference into bins of roughly the same traversal cost.
+         *
+         * Besides the reference symbols, every variant costs the symbols of its branch, i.e. its insertion and the
+         * `window_size - 1` symbols of its context. Thus, regions with a high variant density get smaller bins.
+         * Returns the `bin_count + 1` bin boundaries; empty bins are removed.
+         */
+        template <sequence_tree tree_t>
+        std::vector<std::size_t> balanced_bins(tree_t const & tree, std::size_t const window_size, std::size_t bin_count) {
+            std::size_t const reference_size = std::ranges::size(tree.reference());
+            auto const & variants = tree.variants();
+            auto branch_cost = [&] (auto const & variant) {
+                return std::ranges::size(variant.insertion) + window_size;
+            };
+
+            std::size_t total_cost = reference_size;
+            for (auto const & variant : variants)
+                total_cost += branch_cost(variant);
+
+            bin_count = std::max<std::size_t>(bin_count, 1);
+            std::vector<std::size_t> boundaries{0};
+            std::size_t cost{}; // cost of all symbols and variants before the current position.
+            std::size_t position{};
+            auto variant_it = std::ranges::begin(variants);
+            for (std::size_t bin = 1; bin < bin_count; ++bin) {
+                std::size_t const target_cost = total_cost * bin / bin_count;
+                while (cost < target_cost && position < reference_size) {
+                    std::size_t const next_variant_position = (variant_it == std::ranges::end(variants))
+                                                            ? reference_size
+                                                            : variant_it->position;
+                    if (position == next_variant_position) {
+                        cost += branch_cost(*variant_it);
+                        ++variant_it;
+                        continue;
+                    }
+
+                    std::size_t const step = std::min(next_variant_position - position, target_cost - cost);
+                    position += step;
+                    cost += step;
+                }
+
+                if (position > boundaries.back() && position < reference_size)
+                    boundaries.push_back(position);
+            }
+            boundaries.push_back(reference_size);
+            return boundaries;
+        }
+    } // namespace detail
+
+    /*!\brief Searches all haplotypes of a sequence tree concurrently.
+     * \param tree The sequence tree modelling spm::sequence_tree.
+     * \param matcher The restorable matcher used to search the tree; every bin searches with its own copy.
+     * \param callback The callback invoked with the spm::jst_hit and the spm::coverage of every hit.
+     * \param thread_count The number of threads used for the traversal.
+     * \throws Any exception thrown by the matcher or the callback, which is rethrown on the calling thread.
+     *
+     * The reference is partitioned into bins balanced by the number of reference symbols and the variant density.
+     * Every bin is traversed with a copy of the matcher after it has been fed with the `window_size - 1` reference
+     * symbols preceding the bin. A bin reports only the reference hits ending within the bin and the hits of the
+     * branches opened by its variants, such that no hit of the overlapping context is reported twice.
+     * The callback is invoked on the calling thread in the same order as by spm::jst_search, while the remaining bins are
+     * still traversed.
+     */
+    template <sequence_tree tree_t, restorable_matcher matcher_t, typename callback_t>
+    void parallel_jst_search(tree_t const & tree,
+                             matcher_t const & matcher,
+                             callback_t && callback,
+                             std::size_t const thread_count = std::thread::hardware_concurrency()) {
+        using hit_list_t = std::vector<std::pair<jst_hit, spm::coverage>>;
+
+        std::size_t const window_size = spm::window_size(matcher);
+        std::size_t const worker_count = std::max<std::size_t>(thread_count, 1);
+        // Use more bins than threads to compensate for the remaining imbalance.
+        std::vector<std::size_t> const boundaries = detail::balanced_bins(tree, window_size, worker_count * 4);
+        std::size_t const bin_count = boundaries.size() - 1;
+
+        auto const & variants = tree.variants();
+        std::size_t max_deletion_length{};
+        for (auto const & variant : variants)
+            max_deletion_length = std::max<std::size_t>(max_deletion_length, variant.deletion_length);
+
+        std::vector<hit_list_t> bin_hits(bin_count);
+        std::vector<std::exception_ptr> bin_exceptions(bin_count);
+        std::vector<std::atomic<bool>> bin_done(bin_count);
+        std::atomic<std::size_t> next_bin{};
+
+        auto traverse_bin = [&] (std::size_t const bin) {
+            std::size_t const begin = boundaries[bin];
+            std::size_t const end = boundaries[bin + 1];
+
+            // Start with the first variant that might overlap the context of the bin.
+            std::size_t const first_position = begin - std::min(begin, window_size + max_deletion_length);
+            auto first_variant = std::ranges::lower_bound(variants, first_position, std::ranges::less{},
+                                                          [] (auto const & variant) { return variant.position; });
+            auto bin_variants = std::ranges::subrange{first_variant, std::ranges::end(variants)};
+
+            matcher_t bin_matcher{matcher};
+            hit_list_t & hits = bin_hits[bin];
+            auto collect = [&] (jst_hit const & hit, spm::coverage const & coverage) {
+                hits.emplace_back(hit, coverage);
+            };
+            detail::jst_traverser traverser{tree.reference(),
+                                            bin_variants,
+                                            tree.haplotype_count(),
+                                            bin_matcher,
+                                            collect,
+                                            first_variant - std::ranges::begin(variants)};
+            traverser(begin, end);
+        };
+
+        auto traverse_bins = [&] () {
+            for (std::size_t bin = next_bin++; bin < bin_count; bin = next_bin++) {
+                try {
+                    traverse_bin(bin);
+                } catch (...) {
+                    bin_exceptions[bin] = std::current_exception();
+                }
+                bin_done[bin].store(true, std::memory_order_release);
+                bin_done[bin].notify_one();
+            }
+        };
+
+        std::vector<std::jthread> workers{};
+        if (worker_count == 1) {
+            traverse_bins();
+        } else {
+            workers.reserve(worker_count);
+            for (std::size_t worker = 0; worker < worker_count; ++worker)
+                workers.emplace_back(traverse_bins);
+        }
+
+        // Replay the hits in the order of the bins.
+        try {
+            for (std::size_t bin = 0; bin < bin_count; ++bin) {
+                bin_done[bin].wait(false, std::memory_order_acquire);
+                if (bin_exceptions[bin])
+                    std::rethrow_exception(bin_exceptions[bin]);
+
+                for (auto const & [hit, coverage] : bin_hits[bin])
+                    callback(hit, coverage);
+                hit_list_t{}.swap(bin_hits[bin]);
+            }
+        } catch (...) {
+            next_bin.store(bin_count); // the workers skip the remaining bins and are joined while unwinding.
+            throw;
+        }
+    }
+
+}  // namespace spm
@@ -0,0 +1,334 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a streaming reader for the phased genotypes of a VCF file.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+
+#include <libspm/jst/coverage.hpp>
+#include <libspm/jst/journaled_sequence_tree.hpp>
+#include <libspm/seqan/rank_conversion.hpp>
+
+namespace spm
+{
+    /*!\brief Reads the variants of a VCF file lazily as spm::sequence_variant.
+     *
+     * Every alternative allele of a record becomes one variant covering the haplotypes whose genotype refers to it.
+     * Sample `s` contributes the haplotypes `s * ploidy() + h` for every allele `h` of its genotype; the ploidy is taken
+     * from the first record. The alleles are normalised by removing the common prefix of the reference and the
+     * alternative allele, e.g. the padding base of insertions and deletions. Symbolic alleles, breakends and missing
+     * genotypes are ignored. The records must be sorted by position and refer to a single contig.
+     *
+     * The reader is an input range and can be iterated only once. Only the variants of the current record and those
+     * that need to be reordered after normalisation are kept in memory.
+     */
+    template <seqan3::writable_alphabet alphabet_t>
+    class vcf_reader
+    {
+    public:
+
+        using variant_type = sequence_variant<alphabet_t>;
+
+        class iterator;
+
+    private:
+
+        static constexpr std::size_t fixed_column_count = 9; // CHROM POS ID REF ALT QUAL FILTER INFO FORMAT
+
+        std::istream * _stream{};
+        std::vector<std::string> _sample_names{};
+        std::size_t _ploidy{2};
+
+        std::string _line{};
+        bool _has_line{};
+        std::size_t _line_position{}; // 0-based position of the buffered record.
+
+        std::vector<variant_type> _pending{}; // heap of normalised variants not yet emitted.
+        std::vector<uint8_t> _ranks{}; // conversion buffer reused for all alleles.
+        variant_type _current{};
+        bool _at_end{};
+
+    public:
+
+        vcf_reader() = delete;
+        /*!\brief Constructs the reader and parses the header of the given stream.
+         * \throws std::runtime_error if the header line is missing or malformed.
+         */
+        explicit vcf_reader(std::istream & stream) : _stream{std::addressof(stream)}
+        {
+            read_header();
+            read_line();
+            if (_has_line)
+                _ploidy = std::max<std::size_t>(1, detect_ploidy(_line));
+        }
+
+        constexpr std::vector<std::string> const & sample_names() const noexcept {
+            return _sample_names;
+        }
+
+        constexpr std::size_t ploidy() const noexcept {
+            return _ploidy;
+        }
+
+        //!\brief The number of haplotypes, i.e. the size of the coverage of every variant.
+        constexpr std::size_t haplotype_count() const noexcept {
+            return _sample_names.size() * _ploidy;
+        }
+
+        iterator begin() {
+            next();
+            return iterator{this};
+        }
+
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+    private:
+
+        // ----------------------------------------------------------------------------
+        // Record handling
+        // ----------------------------------------------------------------------------
+
+        void next() {
+            while (true) {
+                // Variants of later records never start before the position of the buffered record.
+                if (!_pending.empty() && (!_has_line || _pending.front().position < _line_position)) {
+                    std::ranges::pop_heap(_pending, std::ranges::greater{}, variant_key{});
+                    _current = std::move(_pending.back());
+                    _pending.pop_back();
+                    return;
+                }
+
+                if (!_has_line) {
+                    _at_end = true;
+                    return;
+                }
+
+                parse_record(_line);
+                read_line();
+            }
+        }
+
+        void parse_record(std::string_view const record) {
+            std::vector<std::string_view> columns = split(record, '\t');
+            if (columns.size() < fixed_column_count + _sample_names.size())
+                throw std::runtime_error{"Malformed VCF record: " + std::string{record}};
+
+            std::size_t const position = _line_position;
+            std::string_view const reference_allele = columns[3];
+
+            // Create one variant per valid alternative allele; the index 0 refers to the reference allele.
+            std::vector<std::string_view> alternative_alleles = split(columns[4], ',');
+            std::vector<std::ptrdiff_t> variant_index(alternative_alleles.size() + 1, -1);
+            std::vector<variant_type> variants{};
+            for (std::size_t allele = 0; allele < alternative_alleles.size(); ++allele) {
+                std::string_view const alternative = alternative_alleles[allele];
+                if (!is_sequence_allele(alternative) || alternative == reference_allele)
+                    continue;
+
+                variant_index[allele + 1] = std::ranges::ssize(variants);
+                variants.push_back(normalise(position, reference_allele, alternative));
+            }
+
+            // Set the coverage from the genotypes.
+            std::size_t const genotype_field = field_index(columns[8], "GT");
+            for (std::size_t sample = 0; sample < _sample_names.size(); ++sample) {
+                std::vector<std::string_view> fields = split(columns[fixed_column_count + sample], ':');
+                if (genotype_field >= fields.size())
+                    continue;
+
+                std::size_t haplotype{};
+                for (std::string_view const allele : split_genotype(fields[genotype_field])) {
+                    if (haplotype == _ploidy)
+                        break;
+
+                    std::size_t allele_index{};
+                    auto const result = std::from_chars(allele.data(), allele.data() + allele.size(), allele_index);
+                    if (result.ec == std::errc{} && allele_index < variant_index.size() && variant_index[allele_index] >= 0)
+                        variants[variant_index[allele_index]].coverage.set(sample * _ploidy + haplotype);
+                    ++haplotype;
+                }
+            }
+
+            for (variant_type & variant : variants) {
+                _pending.push_back(std::move(variant));
+                std::ranges::push_heap(_pending, std::ranges::greater{}, variant_key{});
+            }
+        }
+
+        variant_type normalise(std::size_t position,
+                               std::string_view reference_allele,
+                               std::string_view alternative_allele) {
+            std::size_t const common_prefix =
+                std::ranges::mismatch(reference_allele, alternative_allele).in1 - reference_allele.begin();
+            position += common_prefix;
+            reference_allele.remove_prefix(common_prefix);
+            alternative_allele.remove_prefix(common_prefix);
+
+            variant_type variant{.position = position,
+                                 .deletion_length = reference_allele.size(),
+                                 .insertion = {},
+                                 .coverage = spm::coverage(haplotype_count())};
+            if constexpr (rank_convertible_alphabet<alphabet_t>) {
+                _ranks.resize(alternative_allele.size());
+                spm::to_rank<alphabet_t>(alternative_allele, _ranks);
+                variant.insertion.resize(_ranks.size());
+                for (std::size_t index = 0; index < _ranks.size(); ++index)
+                    seqan3::assign_rank_to(_ranks[index], variant.insertion[index]);
+            } else {
+                variant.insertion.reserve(alternative_allele.size());
+                for (char const symbol : alternative_allele)
+                    variant.insertion.push_back(seqan3::assign_char_to(symbol, alphabet_t{}));
+            }
+            return variant;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Line handling
+        // ----------------------------------------------------------------------------
+
+        void read_header() {
+            std::string line{};
+            while (std::getline(*_stream, line)) {
+                if (line.starts_with("##"))
+                    continue;
+
+                if (!line.starts_with("#CHROM"))
+                    break;
+
+                std::vector<std::string_view> columns = split(line, '\t');
+                for (std::size_t column = fixed_column_count; column < columns.size(); ++column)
+                    _sample_names.emplace_back(columns[column]);
+                return;
+            }
+            throw std::runtime_error{"The VCF header line is missing."};
+        }
+
+        void read_line() {
+            _has_line = false;
+            while (std::getline(*_stream, _line)) {
+                if (_line.empty() || _line.starts_with('#'))
+                    continue;
+
+                std::vector<std::string_view> columns = split(_line, '\t');
+                std::size_t position{};
+                if (columns.size() < 2 ||
+                    std::from_chars(columns[1].data(), columns[1].data() + columns[1].size(), position).ec != std::errc{} ||
+                    position == 0)
+                    throw std::runtime_error{"Malformed VCF record: " + _line};
+
+                _line_position = position - 1;
+                _has_line = true;
+                return;
+            }
+        }
+
+        std::size_t detect_ploidy(std::string_view const record) const {
+            std::vector<std::string_view> columns = split(record, '\t');
+            if (columns.size() <= fixed_column_count)
+                return 0;
+
+            std::size_t const genotype_field = field_index(columns[8], "GT");
+            std::vector<std::string_view> fields = split(columns[fixed_column_count], ':');
+            return (genotype_field < fields.size()) ? split_genotype(fields[genotype_field]).size() : 0;
+        }
+
+        static std::size_t field_index(std::string_view const format, std::string_view const key) {
+            std::vector<std::string_view> keys = split(format, ':');
+            return std::ranges::find(keys, key) - keys.begin();
+        }
+
+        static bool is_sequence_allele(std::string_view const allele) noexcept {
+            return !allele.empty() && allele != "." && allele != "*" &&
+                   allele.find_first_of("<>[]") == std::string_view::npos;
+        }
+
+        static std::vector<std::string_view> split_genotype(std::string_view const genotype) {
+            std::vector<std::string_view> alleles{};
+            std::size_t begin{};
+            for (std::size_t end = 0; end <= genotype.size(); ++end) {
+                if (end == genotype.size() || genotype[end] == '|' || genotype[end] == '/') {
+                    alleles.push_back(genotype.substr(begin, end - begin));
+                    begin = end + 1;
+                }
+            }
+            return alleles;
+        }
+
+        static std::vector<std::string_view> split(std::string_view const text, char const delimiter) {
+            std::vector<std::string_view> tokens{};
+            std::size_t begin{};
+            for (std::size_t end = text.find(delimiter); end != std::string_view::npos; end = text.find(delimiter, begin)) {
+                tokens.push_back(text.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            tokens.push_back(text.substr(begin));
+            return tokens;
+        }
+
+        struct variant_key
+        {
+            constexpr auto operator()(variant_type const & variant) const noexcept {
+                return detail::variant_order_key(variant);
+            }
+        };
+    };
+
+    template <seqan3::writable_alphabet alphabet_t>
+    class vcf_reader<alphabet_t>::iterator
+    {
+    private:
+
+        vcf_reader * _host{};
+
+    public:
+
+        using value_type = variant_type;
+        using reference = variant_type const &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+        explicit iterator(vcf_reader * host) noexcept : _host{host}
+        {}
+
+        reference operator*() const noexcept {
+            return _host->_current;
+        }
+
+        iterator & operator++() {
+            _host->next();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++(*this);
+        }
+
+        bool operator==(std::default_sentinel_t const &) const noexcept {
+            return _host->_at_end;
+        }
+    };
+
+}  // namespace spm
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the variant-aware search of a reference and a VCF file.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <istream>
+#include <ranges>
+
+#include <libspm/jst/jst_search.hpp>
+#include <libspm/jst/vcf_reader.hpp>
+#include <libspm/matcher/concept.hpp>
+
+namespace spm
+{
+    /*!\brief Searches all haplotypes of a VCF file without materialising them.
+     * \param reference The reference sequence the VCF file refers to.
+     * \param vcf_stream The stream containing the VCF file sorted by position.
+     * \param matcher The restorable matcher used to search the haplotypes.
+     * \param callback The callback invoked with the spm::jst_hit and the spm::coverage of every hit.
+     *
+     * The records are read while the reference is scanned, see spm::jst_search. Haplotype `h` of the coverage
+     * corresponds to the allele `h % ploidy` of the sample `h / ploidy` as described by spm::vcf_reader.
+     */
+    template <std::ranges::random_access_range reference_t, restorable_matcher matcher_t, typename callback_t>
+    void vcf_search(reference_t const & reference, std::istream & vcf_stream, matcher_t & matcher, callback_t && callback) {
+        vcf_reader<std::ranges::range_value_t<reference_t>> reader{vcf_stream};
+        spm::jst_search(reference, reader, reader.haplotype_count(), matcher, (callback_t &&) callback);
+    }
+
+}  // namespace spm
@@ -0,0 +1,384 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides type-erased matchers that are dispatched once per searched haystack.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    namespace detail
+    {
+        /*!\brief A copyable value of any type that is stored inline if it fits into `buffer_size` bytes.
+         *
+         * Values that are larger, over-aligned or not nothrow move constructible are allocated on the heap instead.
+         */
+        template <std::size_t buffer_size>
+        class small_buffer_any
+        {
+        private:
+
+            struct storage_operations
+            {
+                void (*copy)(void const * source, small_buffer_any & target);
+                void (*move)(small_buffer_any & source, small_buffer_any & target) noexcept;
+                void (*destroy)(void * object) noexcept;
+            };
+
+            template <typename value_t>
+            static constexpr bool stored_inline = sizeof(value_t) <= buffer_size &&
+                                                  alignof(value_t) <= alignof(std::max_align_t) &&
+                                                  std::is_nothrow_move_constructible_v<value_t>;
+
+            alignas(std::max_align_t) std::array<std::byte, buffer_size> _buffer;
+            void * _object{};
+            storage_operations const * _operations{};
+
+        public:
+
+            small_buffer_any() noexcept = default;
+            small_buffer_any(small_buffer_any const & other) {
+                if (other._operations != nullptr)
+                    other._operations->copy(other._object, *this);
+            }
+
+            small_buffer_any(small_buffer_any && other) noexcept {
+                if (other._operations != nullptr)
+                    other._operations->move(other, *this);
+            }
+
+            small_buffer_any & operator=(small_buffer_any const & other) {
+                if (this != std::addressof(other)) {
+                    reset();
+                    if (other._operations != nullptr)
+                        other._operations->copy(other._object, *this);
+                }
+                return *this;
+            }
+
+            small_buffer_any & operator=(small_buffer_any && other) noexcept {
+                if (this != std::addressof(other)) {
+                    reset();
+                    if (other._operations != nullptr)
+                        other._operations->move(other, *this);
+                }
+                return *this;
+            }
+
+            ~small_buffer_any() {
+                reset();
+            }
+
+            template <typename value_t, typename ...args_t>
+            value_t & emplace(args_t && ...args) {
+                reset();
+                construct<value_t>((args_t &&) args...);
+                return get<value_t>();
+            }
+
+            void reset() noexcept {
+                if (_operations != nullptr) {
+                    _operations->destroy(_object);
+                    _object = nullptr;
+                    _operations = nullptr;
+                }
+            }
+
+            bool has_value() const noexcept {
+                return _operations != nullptr;
+            }
+
+            template <typename value_t>
+            bool holds() const noexcept {
+                return _operations == std::addressof(operations_for<value_t>);
+            }
+
+            template <typename value_t>
+            value_t & get() noexcept {
+                assert(holds<value_t>());
+                return *static_cast<value_t *>(_object);
+            }
+
+            template <typename value_t>
+            value_t const & get() const noexcept {
+                assert(holds<value_t>());
+                return *static_cast<value_t const *>(_object);
+            }
+
+        private:
+
+            template <typename value_t, typename ...args_t>
+            void construct(args_t && ...args) {
+                if constexpr (stored_inline<value_t>)
+                    _object = ::new (_buffer.data()) value_t((args_t &&) args...);
+                else
+                    _object = new value_t((args_t &&) args...);
+                _operations = std::addressof(operations_for<value_t>);
+            }
+
+            template <typename value_t>
+            static constexpr storage_operations operations_for{
+                .copy = [] (void const * source, small_buffer_any & target) {
+                    target.template construct<value_t>(*static_cast<value_t const *>(source));
+                },
+                .move = [] (small_buffer_any & source, small_buffer_any & target) noexcept {
+                    if constexpr (stored_inline<value_t>) {
+                        value_t * object = static_cast<value_t *>(source._object);
+                        target._object = ::new (target._buffer.data()) value_t(std::move(*object));
+                        std::destroy_at(object);
+                    } else {
+                        target._object = source._object;
+                    }
+                    target._operations = std::exchange(source._operations, nullptr);
+                    source._object = nullptr;
+                },
+                .destroy = [] (void * object) noexcept {
+                    if constexpr (stored_inline<value_t>)
+                        std::destroy_at(static_cast<value_t *>(object));
+                    else
+                        delete static_cast<value_t *>(object);
+                }
+            };
+        };
+
+        //!\brief A non-owning reference to a hit callback, which is invoked with a spm::matcher_hit.
+        class hit_callback_ref
+        {
+        private:
+
+            void * _callback{};
+            search_control (*_invoke)(void *, matcher_hit const &){};
+
+        public:
+
+            hit_callback_ref() = delete;
+            template <typename callback_t>
+                requires (!std::same_as<std::remove_cvref_t<callback_t>, hit_callback_ref>)
+            explicit hit_callback_ref(callback_t & callback) noexcept :
+                _callback{const_cast<void *>(static_cast<void const *>(std::addressof(callback)))},
+                _invoke{[] (void * callback, matcher_hit const & hit) {
+                    return detail::invoke_hit_callback(*static_cast<callback_t *>(callback), hit);
+                }}
+            {}
+
+            search_control operator()(matcher_hit const & hit) const {
+                return _invoke(_callback, hit);
+            }
+        };
+
+        //!\brief Searches the haystack with the given matcher and reports every hit as spm::matcher_hit.
+        template <typename matcher_t, typename haystack_t>
+        search_control search_erased(matcher_t & matcher,
+                                     haystack_t haystack,
+                                     std::size_t const base_offset,
+                                     hit_callback_ref const callback) {
+            auto report = [&] (auto const & hit) {
+                return callback(matcher_hit{.begin_position = hit.begin_position, .end_position = hit.end_position});
+            };
+            auto report_shifted = [&] (auto const & hit) {
+                return callback(matcher_hit{.begin_position = hit.begin_position + base_offset,
+                                            .end_position = hit.end_position + base_offset});
+            };
+
+            auto search = [&] () {
+                if constexpr (std::invocable<matcher_t &, haystack_t, std::size_t, decltype(report) &>)
+                    return matcher(std::move(haystack), base_offset, report);
+                else
+                    return matcher(std::move(haystack), report_shifted);
+            };
+
+            if constexpr (std::same_as<decltype(search()), search_control>) {
+                return search();
+            } else {
+                search();
+                return search_control::proceed;
+            }
+        }
+
+        //!\brief The implementation of spm::any_matcher and spm::any_restorable_matcher.
+        template <std::ranges::view haystack_t, std::size_t buffer_size, bool is_restorable>
+        class basic_any_matcher;
+    } // namespace detail
+
+    //!\brief The number of bytes of the inline buffer of spm::any_matcher_state.
+    inline constexpr std::size_t any_matcher_state_buffer_size = 64;
+
+    /*!\brief The type-erased state captured from a spm::any_restorable_matcher.
+     *
+     * The states of the bit-parallel matchers are stored in a fixed-size inline buffer, such that capturing and
+     * restoring does not allocate. Larger states are allocated on the heap.
+     */
+    class any_matcher_state : public detail::small_buffer_any<any_matcher_state_buffer_size>
+    {};
+
+    /*!\brief A type-erased spm::window_matcher searching haystacks of type `haystack_t`.
+     * \tparam haystack_t The view type of the searched haystacks, e.g. `std::span<spm::dna4 const>`.
+     * \tparam buffer_size The number of bytes of the inline buffer storing the wrapped matcher.
+     *
+     * Allows to select the matcher at runtime, e.g. from a configuration, without instantiating the surrounding code
+     * for every matcher type. The wrapped matcher is called once per haystack, which is typically a chunk of a larger
+     * sequence, such that the cost of the indirect call is paid once per chunk and not per symbol. Only the callback
+     * is invoked indirectly per hit. All hits are reported as spm::matcher_hit.
+     * Matchers fitting into `buffer_size` bytes are stored inline, larger ones are allocated on the heap.
+     */
+    template <std::ranges::view haystack_t, std::size_t buffer_size = 64>
+    using any_matcher = detail::basic_any_matcher<haystack_t, buffer_size, false>;
+
+    /*!\brief A type-erased spm::restorable_matcher searching haystacks of type `haystack_t`.
+     *
+     * In addition to spm::any_matcher, the state of the wrapped matcher can be captured into and restored from a
+     * spm::any_matcher_state. A state may only be restored into a matcher wrapping the same matcher type.
+     */
+    template <std::ranges::view haystack_t, std::size_t buffer_size = 64>
+    using any_restorable_matcher = detail::basic_any_matcher<haystack_t, buffer_size, true>;
+
+    namespace detail
+    {
+        template <std::ranges::view haystack_t, std::size_t buffer_size, bool is_restorable>
+        class basic_any_matcher
+        {
+        private:
+
+            using storage_type = small_buffer_any<buffer_size>;
+
+            struct matcher_operations
+            {
+                search_control (*search)(storage_type &, haystack_t, std::size_t, hit_callback_ref);
+                std::size_t (*window_size)(storage_type const &) noexcept;
+                void (*capture)(storage_type const &, any_matcher_state &);
+                void (*restore)(storage_type &, any_matcher_state const &);
+            };
+
+            template <typename matcher_t>
+            static constexpr matcher_operations operations_for{
+                .search = [] (storage_type & storage,
+                              haystack_t haystack,
+                              std::size_t const base_offset,
+                              hit_callback_ref const callback) {
+                    return detail::search_erased(storage.template get<matcher_t>(),
+                                                 std::move(haystack),
+                                                 base_offset,
+                                                 callback);
+                },
+                .window_size = [] (storage_type const & storage) noexcept {
+                    return static_cast<std::size_t>(spm::window_size(storage.template get<matcher_t>()));
+                },
+                .capture = [] (storage_type const & storage, any_matcher_state & state) {
+                    if constexpr (is_restorable) {
+                        using state_t = matcher_state_t<matcher_t const &>;
+                        state.template emplace<state_t>(spm::capture(storage.template get<matcher_t>()));
+                    }
+                },
+                .restore = [] (storage_type & storage, any_matcher_state const & state) {
+                    if constexpr (is_restorable) {
+                        using state_t = matcher_state_t<matcher_t const &>;
+                        spm::restore(storage.template get<matcher_t>(), state.template get<state_t>());
+                    }
+                }
+            };
+
+            storage_type _matcher{};
+            matcher_operations const * _operations{};
+
+        public:
+
+            //!\brief Constructs an empty matcher, which must be assigned before it is used.
+            basic_any_matcher() = default;
+            basic_any_matcher(basic_any_matcher const &) = default;
+            basic_any_matcher(basic_any_matcher && other) noexcept :
+                _matcher{std::move(other._matcher)},
+                _operations{std::exchange(other._operations, nullptr)}
+            {}
+
+            basic_any_matcher & operator=(basic_any_matcher const &) = default;
+            basic_any_matcher & operator=(basic_any_matcher && other) noexcept {
+                if (this != std::addressof(other)) {
+                    _matcher = std::move(other._matcher);
+                    _operations = std::exchange(other._operations, nullptr);
+                }
+                return *this;
+            }
+
+            //!\brief Wraps the given matcher.
+            template <typename matcher_t>
+                requires (!std::same_as<std::remove_cvref_t<matcher_t>, basic_any_matcher>) &&
+                         window_matcher<std::remove_cvref_t<matcher_t> &> &&
+                         (!is_restorable || restorable_matcher<std::remove_cvref_t<matcher_t> &>)
+            basic_any_matcher(matcher_t && matcher) :
+                _operations{std::addressof(operations_for<std::remove_cvref_t<matcher_t>>)}
+            {
+                _matcher.template emplace<std::remove_cvref_t<matcher_t>>((matcher_t &&) matcher);
+            }
+
+            template <typename callback_t>
+            search_control operator()(haystack_t haystack, callback_t && callback) {
+                return (*this)(std::move(haystack), 0, (callback_t &&) callback);
+            }
+
+            //!\brief Searches a part of a larger haystack starting at `base_offset`.
+            template <typename callback_t>
+            search_control operator()(haystack_t haystack, std::size_t const base_offset, callback_t && callback) {
+                assert(_operations != nullptr);
+                return _operations->search(_matcher, std::move(haystack), base_offset, hit_callback_ref{callback});
+            }
+
+            //!\brief Returns a pointer to the wrapped matcher if it is of type `matcher_t`, otherwise `nullptr`.
+            template <typename matcher_t>
+            matcher_t * target() noexcept {
+                return _matcher.template holds<matcher_t>() ? std::addressof(_matcher.template get<matcher_t>())
+                                                            : nullptr;
+            }
+
+            template <typename matcher_t>
+            matcher_t const * target() const noexcept {
+                return _matcher.template holds<matcher_t>() ? std::addressof(_matcher.template get<matcher_t>())
+                                                            : nullptr;
+            }
+
+            explicit operator bool() const noexcept {
+                return _operations != nullptr;
+            }
+
+            any_matcher_state capture() const requires is_restorable {
+                assert(_operations != nullptr);
+                any_matcher_state state{};
+                _operations->capture(_matcher, state);
+                return state;
+            }
+
+            void restore(any_matcher_state const & state) requires is_restorable {
+                assert(_operations != nullptr);
+                _operations->restore(_matcher, state);
+            }
+
+        private:
+
+            friend std::size_t tag_invoke(std::tag_t<spm::window_size>, basic_any_matcher const & me) noexcept {
+                assert(me._operations != nullptr);
+                return me._operations->window_size(me._matcher);
+            }
+        };
+    } // namespace detail
+
+}  // namespace spm
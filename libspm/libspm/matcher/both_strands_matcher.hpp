@@ -0,0 +1,309 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a matcher searching a nucleotide needle and its reverse complement in a single pass.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/alphabet/nucleotide/concept.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    //!\brief The strand a hit was found on.
+    enum class strand : uint8_t
+    {
+        forward, //!< The hit is an occurrence of the needle.
+        reverse //!< The hit is an occurrence of the reverse complement of the needle.
+    };
+
+    //!\brief A hit of the spm::both_strands_matcher in the coordinates of the forward haystack.
+    struct stranded_hit
+    {
+        std::size_t begin_position{}; //!< The begin position of the hit.
+        std::size_t end_position{}; //!< The end position of the hit (exclusive).
+        spm::strand strand{spm::strand::forward}; //!< The strand the hit was found on.
+
+    private:
+
+        constexpr friend bool operator==(stranded_hit const &, stranded_hit const &) noexcept = default;
+    };
+
+    //!\brief The state of a spm::both_strands_matcher.
+    template <typename forward_state_t, typename reverse_state_t>
+    struct both_strands_state
+    {
+        forward_state_t forward{}; //!< The state of the forward strand.
+        reverse_state_t reverse{}; //!< The state of the reverse strand.
+        std::vector<stranded_hit> pending_hits{}; //!< The hits not yet reported when the search was stopped.
+    };
+
+    //!\brief Returns the reverse complement of a nucleotide sequence.
+    template <std::ranges::input_range sequence_t>
+        requires seqan3::nucleotide_alphabet<std::ranges::range_value_t<sequence_t>>
+    auto reverse_complement(sequence_t && sequence) {
+        using alphabet_t = std::ranges::range_value_t<sequence_t>;
+        using rank_t = seqan3::alphabet_rank_t<alphabet_t>;
+
+        std::vector<alphabet_t> result{};
+        for (auto && symbol : sequence) {
+            // The complement of an adapted alphabet is the wrapped alphabet, which has the same ranks.
+            rank_t const rank = static_cast<rank_t>(seqan3::to_rank(seqan3::complement(symbol)));
+            result.push_back(seqan3::assign_rank_to(rank, alphabet_t{}));
+        }
+        std::ranges::reverse(result);
+        return result;
+    }
+
+    /*!\brief Searches a needle and its reverse complement with a pair of matchers on the same haystack.
+     * \tparam forward_matcher_t The type of the matcher built on the needle.
+     * \tparam reverse_matcher_t The type of the matcher built on the reverse complement of the needle.
+     *
+     * The haystack is processed in chunks of spm::both_strands_matcher::chunk_size symbols. Every chunk is scanned by
+     * both matchers while it still resides in the cache, such that the haystack is loaded from memory only once.
+     * Restorable matchers carry their state over to the next chunk. Other matchers search every chunk together with
+     * the preceding window, i.e. the last `window_size - 1` symbols of the previous chunk, and the hits ending within
+     * this window, which were already found in the previous chunk, are skipped.
+     * The hits of both strands are reported as spm::stranded_hit ordered by their end position, where hits of the
+     * forward strand precede hits of the reverse strand with the same end position.
+     *
+     * The matcher is restorable if both matchers are restorable; its state is a spm::both_strands_state.
+     * If the callback stops the search, both strands are brought to the end position of the stopping hit, such that
+     * the search can be resumed from there. The hits of the reverse strand ending at the same position that follow
+     * the stopping hit are kept and reported first by the next search.
+     *
+     * The matchers may refer to needles owned by the wrapper, which are shared between its copies, e.g. the reverse
+     * complement computed by spm::make_both_strands_matcher.
+     */
+    template <window_matcher forward_matcher_t, window_matcher reverse_matcher_t = forward_matcher_t>
+    class both_strands_matcher
+    {
+    private:
+
+        static constexpr bool is_restorable = restorable_matcher<forward_matcher_t &> &&
+                                              restorable_matcher<reverse_matcher_t &>;
+
+        forward_matcher_t _forward_matcher;
+        reverse_matcher_t _reverse_matcher;
+        std::vector<matcher_hit> _reverse_hits{}; // buffer for the reverse hits of the current chunk.
+        std::vector<stranded_hit> _pending_hits{}; // the hits following a stopping hit at its end position.
+        std::shared_ptr<void const> _needles{}; // keeps the needles the matchers refer to alive.
+
+    public:
+
+        //!\brief The number of symbols scanned by both matchers before advancing to the next chunk.
+        static constexpr std::size_t chunk_size = 1 << 14;
+
+        both_strands_matcher() = delete;
+        /*!\brief Constructs the matcher from the matchers of both strands.
+         * \param forward_matcher The matcher built on the needle.
+         * \param reverse_matcher The matcher built on the reverse complement of the needle.
+         * \param needles The storage of the needles the matchers refer to, if they do not own them.
+         */
+        both_strands_matcher(forward_matcher_t forward_matcher,
+                             reverse_matcher_t reverse_matcher,
+                             std::shared_ptr<void const> needles = nullptr) :
+            _forward_matcher{std::move(forward_matcher)},
+            _reverse_matcher{std::move(reverse_matcher)},
+            _needles{std::move(needles)}
+        {}
+
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+            requires std::ranges::random_access_range<haystack_t> && std::ranges::sized_range<haystack_t>
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) {
+            return (*this)((haystack_t &&) haystack, 0, (callback_t &&) callback);
+        }
+
+        /*!\brief Searches both strands in a part of a larger haystack.
+         * \param haystack The searched part.
+         * \param base_offset The position of the first symbol of the searched part within the larger haystack.
+         * \param callback The callback invoked with a spm::stranded_hit for every hit.
+         * \returns spm::search_control::stop if the callback stopped the search, otherwise
+         *          spm::search_control::proceed.
+         */
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+            requires std::ranges::random_access_range<haystack_t> && std::ranges::sized_range<haystack_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            if (report_pending_hits(callback) == search_control::stop)
+                return search_control::stop;
+
+            std::size_t const haystack_size = std::ranges::size(haystack);
+            std::size_t const overlap = (is_restorable) ? 0 : std::max<std::size_t>(spm::window_size(*this), 1) - 1;
+
+            auto haystack_begin = std::ranges::begin(haystack);
+            for (std::size_t begin = 0; begin < haystack_size; begin += chunk_size) {
+                std::size_t const end = std::min(begin + chunk_size, haystack_size);
+                std::size_t const chunk_begin = begin - std::min(begin, overlap);
+                if (search_chunk(std::ranges::subrange{haystack_begin + chunk_begin, haystack_begin + end},
+                                 base_offset + chunk_begin,
+                                 base_offset + begin,
+                                 callback) == search_control::stop)
+                    return search_control::stop;
+            }
+            return search_control::proceed;
+        }
+
+        constexpr forward_matcher_t const & forward_matcher() const noexcept {
+            return _forward_matcher;
+        }
+
+        constexpr reverse_matcher_t const & reverse_matcher() const noexcept {
+            return _reverse_matcher;
+        }
+
+        constexpr auto capture() const
+            requires is_restorable
+        {
+            using state_t = both_strands_state<matcher_state_t<forward_matcher_t const &>,
+                                               matcher_state_t<reverse_matcher_t const &>>;
+            return state_t{.forward = spm::capture(_forward_matcher),
+                           .reverse = spm::capture(_reverse_matcher),
+                           .pending_hits = _pending_hits};
+        }
+
+        template <typename state_t>
+            requires is_restorable
+        constexpr void restore(state_t && state) {
+            spm::restore(_forward_matcher, ((state_t &&) state).forward);
+            spm::restore(_reverse_matcher, ((state_t &&) state).reverse);
+            _pending_hits = ((state_t &&) state).pending_hits;
+        }
+
+    private:
+
+        template <typename callback_t>
+        constexpr search_control report_pending_hits(callback_t & callback) {
+            auto pending_it = _pending_hits.begin();
+            search_control control{search_control::proceed};
+            while (control == search_control::proceed && pending_it != _pending_hits.end())
+                control = detail::invoke_hit_callback(callback, *pending_it++);
+            _pending_hits.erase(_pending_hits.begin(), pending_it);
+            return control;
+        }
+
+        // Reports the hits of the chunk ending behind `report_begin`.
+        template <typename chunk_t, typename callback_t>
+        constexpr search_control search_chunk(chunk_t && chunk,
+                                              std::size_t const offset,
+                                              std::size_t const report_begin,
+                                              callback_t & callback) {
+            // Both strands are searched beyond a stopping hit and are reset to the state before the chunk.
+            auto chunk_state = [&] () {
+                if constexpr (is_restorable)
+                    return std::pair{spm::capture(_forward_matcher), spm::capture(_reverse_matcher)};
+                else
+                    return nullptr;
+            }();
+
+            _reverse_hits.clear();
+            _reverse_matcher(chunk, offset, [&] (matcher_hit const & hit) {
+                if (hit.end_position > report_begin)
+                    _reverse_hits.push_back(hit);
+            });
+
+            search_control control{search_control::proceed};
+            std::size_t stop_position{};
+            auto report = [&] (matcher_hit const & hit, spm::strand const hit_strand) {
+                control = detail::invoke_hit_callback(callback,
+                                                      stranded_hit{hit.begin_position, hit.end_position, hit_strand});
+                stop_position = hit.end_position;
+            };
+
+            auto reverse_it = _reverse_hits.begin();
+            auto report_reverse_until = [&] (std::size_t const end_position) {
+                for (; control == search_control::proceed && reverse_it != _reverse_hits.end() &&
+                       reverse_it->end_position < end_position; ++reverse_it)
+                    report(*reverse_it, strand::reverse);
+            };
+
+            _forward_matcher(chunk, offset, [&] (matcher_hit const & hit) {
+                if (hit.end_position <= report_begin)
+                    return search_control::proceed;
+
+                report_reverse_until(hit.end_position);
+                if (control == search_control::proceed)
+                    report(hit, strand::forward);
+                return control;
+            });
+            report_reverse_until(std::numeric_limits<std::size_t>::max());
+
+            if (control == search_control::stop) {
+                for (; reverse_it != _reverse_hits.end() && reverse_it->end_position == stop_position; ++reverse_it)
+                    _pending_hits.push_back(stranded_hit{reverse_it->begin_position,
+                                                         reverse_it->end_position,
+                                                         strand::reverse});
+            }
+
+            if constexpr (is_restorable) {
+                if (control == search_control::stop) {
+                    spm::restore(_forward_matcher, chunk_state.first);
+                    spm::restore(_reverse_matcher, chunk_state.second);
+                    auto const chunk_begin = std::ranges::begin(chunk);
+                    std::ranges::subrange const prefix{chunk_begin, chunk_begin + (stop_position - offset)};
+                    _forward_matcher(prefix, offset, [] (matcher_hit const &) {});
+                    _reverse_matcher(prefix, offset, [] (matcher_hit const &) {});
+                }
+            }
+            return control;
+        }
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>, both_strands_matcher const & me) noexcept {
+            return std::max<std::size_t>(spm::window_size(me._forward_matcher), spm::window_size(me._reverse_matcher));
+        }
+    };
+
+    /*!\brief Creates a spm::both_strands_matcher for a nucleotide needle.
+     * \param needle The needle; a borrowed needle, e.g. an lvalue, must outlive the matcher.
+     * \param make_matcher A callable creating a matcher from a view of a needle, e.g.
+     *                     `[] (auto && n) { return spm::restorable_myers_matcher{(decltype(n) &&) n, 2u}; }`.
+     *
+     * The reverse complement of the needle and a needle that is not borrowed, e.g. a temporary, are stored by the
+     * created matcher and are passed to `make_matcher` as a std::ranges::ref_view. Hence, the created matcher is
+     * copyable if the matchers built on views are.
+     */
+    template <std::ranges::viewable_range needle_t, typename make_matcher_t>
+        requires seqan3::nucleotide_alphabet<std::ranges::range_value_t<needle_t>>
+    auto make_both_strands_matcher(needle_t && needle, make_matcher_t && make_matcher) {
+        using alphabet_t = std::ranges::range_value_t<needle_t>;
+
+        // The forward needle is only stored if the matcher cannot refer to the passed one.
+        auto needles = std::make_shared<std::array<std::vector<alphabet_t>, 2>>();
+        (*needles)[1] = spm::reverse_complement(needle);
+        auto reverse_matcher = make_matcher(std::views::all(std::as_const((*needles)[1])));
+        auto forward_matcher = [&] () {
+            if constexpr (std::ranges::borrowed_range<needle_t>) {
+                return make_matcher((needle_t &&) needle);
+            } else {
+                (*needles)[0].assign(std::ranges::begin(needle), std::ranges::end(needle));
+                return make_matcher(std::views::all(std::as_const((*needles)[0])));
+            }
+        }();
+        return both_strands_matcher{std::move(forward_matcher),
+                                    std::move(reverse_matcher),
+                                    std::shared_ptr<void const>{std::move(needles)}};
+    }
+
+}  // namespace spm
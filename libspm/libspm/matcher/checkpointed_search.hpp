@@ -0,0 +1,228 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the search that stores periodic state checkpoints to update its hits after haystack edits.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+
+namespace spm
+{
+    //!\brief The default distance of two checkpoints of spm::checkpointed_search in haystack symbols.
+    inline constexpr std::size_t default_checkpoint_interval = 4096;
+
+    //!\brief An edit replacing a range of the haystack by a sequence of possibly different length.
+    struct haystack_edit
+    {
+        std::size_t position{}; //!< The begin position of the replaced range in the haystack before the edit.
+        std::size_t erased_size{}; //!< The number of replaced symbols.
+        std::size_t inserted_size{}; //!< The number of symbols inserted in their place.
+
+    private:
+
+        constexpr friend bool operator==(haystack_edit const &, haystack_edit const &) noexcept = default;
+    };
+
+    /*!\brief Searches a haystack once and updates the hits incrementally after edits of the haystack.
+     * \tparam matcher_t The type of the matcher; must model spm::restorable_matcher.
+     * \tparam state_equal_t The predicate comparing two captured states; defaults to `std::ranges::equal_to`.
+     *
+     * The search captures the state of the matcher every `checkpoint_interval` symbols. After an edit, only the part
+     * of the haystack starting at the last checkpoint before the edit is searched again. Once the search has passed
+     * the edit, the state is compared with the old checkpoints behind the edit. Since the state only depends on a
+     * bounded number of preceding symbols, it eventually equals the old checkpoint at the same position in the edited
+     * haystack. From there on the old hits and checkpoints are still valid and are only shifted by the length
+     * difference of the edit. Hence, the costs of an update are proportional to the checkpoint interval and the window
+     * size of the matcher instead of the haystack size.
+     *
+     * The haystack is not owned; the current haystack is passed to every call. The hits are stored as
+     * spm::matcher_hit in the order of their end positions. The default predicate requires an equality comparable
+     * state as provided by the fixed-length matchers and spm::trie_myers_matcher; for other matchers a custom
+     * predicate can be given.
+     */
+    template <typename matcher_t, typename state_equal_t = std::ranges::equal_to>
+        requires restorable_matcher<matcher_t &> &&
+                 std::predicate<state_equal_t const &,
+                                matcher_state_t<matcher_t &> const &,
+                                matcher_state_t<matcher_t &> const &>
+    class checkpointed_search
+    {
+    private:
+
+        using state_type = matcher_state_t<matcher_t &>;
+
+        struct checkpoint
+        {
+            std::size_t position{};
+            state_type state{};
+        };
+
+        matcher_t _matcher;
+        state_equal_t _state_equal{};
+        std::vector<checkpoint> _checkpoints{}; // sorted by position; the first one is the initial state.
+        std::vector<matcher_hit> _hits{};
+        std::size_t _checkpoint_interval{};
+        std::size_t _haystack_size{};
+
+    public:
+
+        checkpointed_search() = delete;
+        /*!\brief Constructs the search from the matcher, whose current state is the state before the haystack.
+         * \param matcher The matcher.
+         * \param checkpoint_interval The maximal distance of two checkpoints; must be greater than zero.
+         * \param state_equal The predicate comparing two states of the matcher.
+         */
+        explicit checkpointed_search(matcher_t matcher,
+                                     std::size_t const checkpoint_interval = default_checkpoint_interval,
+                                     state_equal_t state_equal = {}) :
+            _matcher{std::move(matcher)},
+            _state_equal{std::move(state_equal)},
+            _checkpoint_interval{checkpoint_interval}
+        {
+            assert(_checkpoint_interval > 0);
+            _checkpoints.push_back(checkpoint{.position = 0, .state = spm::capture(_matcher)});
+        }
+
+        //!\brief Searches the complete haystack and replaces all hits and checkpoints.
+        template <std::ranges::random_access_range haystack_t>
+            requires std::ranges::sized_range<haystack_t>
+        void search(haystack_t const & haystack) {
+            _checkpoints.resize(1);
+            _hits.clear();
+            _haystack_size = std::ranges::size(haystack);
+            search_from(haystack, haystack_edit{}, std::vector<checkpoint>{});
+        }
+
+        /*!\brief Updates the hits and checkpoints after the haystack was edited.
+         * \param haystack The haystack after the edit.
+         * \param edit The edit applied to the haystack of the previous call.
+         * \returns The number of symbols searched again.
+         *
+         * Several edits must be applied one at a time in the order they were made.
+         */
+        template <std::ranges::random_access_range haystack_t>
+            requires std::ranges::sized_range<haystack_t>
+        std::size_t update(haystack_t const & haystack, haystack_edit const & edit) {
+            assert(edit.position + edit.erased_size <= _haystack_size);
+            assert(std::ranges::size(haystack) == _haystack_size - edit.erased_size + edit.inserted_size);
+
+            // The last checkpoint not after the edit is unaffected by it and the search restarts from there.
+            auto restart = std::ranges::upper_bound(_checkpoints, edit.position, std::ranges::less{},
+                                                    &checkpoint::position) - 1;
+            // The old checkpoints behind the edit, at which the new search can converge.
+            std::vector<checkpoint> candidates(std::ranges::lower_bound(_checkpoints,
+                                                                        edit.position + edit.erased_size,
+                                                                        std::ranges::less{},
+                                                                        &checkpoint::position),
+                                               _checkpoints.end());
+            _checkpoints.erase(restart + 1, _checkpoints.end());
+            _haystack_size = std::ranges::size(haystack);
+            return search_from(haystack, edit, std::move(candidates));
+        }
+
+        //!\brief The hits in the current haystack ordered by their end positions.
+        constexpr std::vector<matcher_hit> const & hits() const noexcept {
+            return _hits;
+        }
+
+        //!\brief The number of stored checkpoints including the initial state.
+        constexpr std::size_t checkpoint_count() const noexcept {
+            return _checkpoints.size();
+        }
+
+    private:
+
+        // Searches from the last checkpoint until the end of the haystack or until the state converges with one of
+        // the candidates, whose positions refer to the haystack before the edit.
+        template <typename haystack_t>
+        std::size_t search_from(haystack_t const & haystack,
+                                haystack_edit const & edit,
+                                std::vector<checkpoint> candidates) {
+            auto shifted = [&] (std::size_t const position) {
+                return position - edit.erased_size + edit.inserted_size;
+            };
+
+            std::size_t const restart_position = _checkpoints.back().position;
+            std::size_t const window = spm::window_size(_matcher);
+            spm::restore(_matcher, _checkpoints.back().state);
+
+            std::vector<matcher_hit> new_hits{};
+            auto collect = [&] (auto const & hit) {
+                new_hits.push_back(matcher_hit{.begin_position = hit.begin_position,
+                                               .end_position = hit.end_position});
+            };
+
+            auto candidate = candidates.begin();
+            std::size_t position = restart_position;
+            std::size_t next_checkpoint = restart_position + _checkpoint_interval;
+            while (true) {
+                if (candidate != candidates.end() && shifted(candidate->position) == position) {
+                    // Before the window size, the begin positions of the hits depend on their end positions.
+                    if (std::min(candidate->position, position) >= window &&
+                        _state_equal(spm::capture(_matcher), candidate->state))
+                        break;
+                    ++candidate;
+                }
+                if (position == next_checkpoint) {
+                    _checkpoints.push_back(checkpoint{.position = position, .state = spm::capture(_matcher)});
+                    next_checkpoint += _checkpoint_interval;
+                }
+                if (position == _haystack_size)
+                    break;
+
+                std::size_t stop = std::min(next_checkpoint, _haystack_size);
+                if (candidate != candidates.end())
+                    stop = std::min(stop, shifted(candidate->position));
+
+                auto const haystack_begin = std::ranges::begin(haystack);
+                _matcher(std::ranges::subrange{haystack_begin + position, haystack_begin + stop}, position, collect);
+                position = stop;
+            }
+
+            // Replace the stale hits and keep the old hits behind the point of convergence.
+            auto is_before = [] (std::size_t const bound) {
+                return [=] (matcher_hit const & hit) { return hit.end_position <= bound; };
+            };
+            auto const stale_hits = std::ranges::partition_point(_hits, is_before(restart_position));
+            auto const valid_hits = (candidate == candidates.end())
+                                  ? _hits.end()
+                                  : std::ranges::partition_point(stale_hits, _hits.end(),
+                                                                 is_before(candidate->position));
+
+            std::vector<matcher_hit> tail_hits{};
+            tail_hits.reserve(std::ranges::distance(valid_hits, _hits.end()));
+            for (matcher_hit const & hit : std::ranges::subrange{valid_hits, _hits.end()})
+                tail_hits.push_back(matcher_hit{.begin_position = shifted(hit.begin_position),
+                                                .end_position = shifted(hit.end_position)});
+            _hits.erase(stale_hits, _hits.end());
+            _hits.insert(_hits.end(), new_hits.begin(), new_hits.end());
+            _hits.insert(_hits.end(), tail_hits.begin(), tail_hits.end());
+
+            // Keep the old checkpoints from the point of convergence on.
+            for (; candidate != candidates.end(); ++candidate)
+                _checkpoints.push_back(checkpoint{.position = shifted(candidate->position),
+                                                  .state = std::move(candidate->state)});
+
+            return position - restart_position;
+        }
+    };
+
+}  // namespace spm
@@ -0,0 +1,156 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a matcher collapsing runs of neighbouring approximate hits into their local score minimum.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <optional>
+#include <ranges>
+#include <utility>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/search_control.hpp>
+#include <libspm/matcher/stratified_search.hpp>
+
+namespace spm
+{
+    /*!\brief Reports one hit per run of neighbouring end positions of an approximate matcher.
+     * \tparam matcher_t The type of the wrapped matcher modelling spm::scored_matcher, e.g. spm::myers_matcher.
+     *
+     * Every approximate occurrence produces a run of adjacent end positions. Hits whose end positions are at most
+     * `cluster_gap` apart are collapsed into a cluster, which is reported as the hit with the fewest errors, i.e. the
+     * leftmost one among equally good hits. A cluster is reported as spm::scored_hit as soon as the search passed its
+     * last end position by more than `cluster_gap` symbols or when spm::clustered_matcher::flush is called.
+     *
+     * The open cluster is the look-ahead buffer of the matcher. If the wrapped matcher is restorable, the open cluster
+     * is captured and restored together with the state of the wrapped matcher. If the callback stops the search at a
+     * cluster closed by a later hit, the search returns after this later hit, which opened the next cluster; the state
+     * then covers the haystack up to the end of the later hit.
+     */
+    template <scored_matcher matcher_t>
+    class clustered_matcher
+    {
+    public:
+
+        //!\brief The open cluster of hits.
+        struct cluster_type
+        {
+            scored_hit best_hit{}; //!< The hit with the fewest errors of the cluster.
+            std::size_t last_end_position{}; //!< The end position of the last hit of the cluster.
+
+        private:
+
+            constexpr friend bool operator==(cluster_type const &, cluster_type const &) noexcept = default;
+        };
+
+    private:
+
+        matcher_t _matcher;
+        std::size_t _cluster_gap{};
+        std::optional<cluster_type> _cluster{};
+
+    public:
+
+        clustered_matcher() = delete;
+        /*!\brief Constructs the matcher.
+         * \param matcher The wrapped matcher.
+         * \param cluster_gap The maximal distance of two end positions within the same cluster; typically the maximal
+         *                    number of errors of the wrapped matcher.
+         */
+        clustered_matcher(matcher_t matcher, std::size_t const cluster_gap) :
+            _matcher{std::move(matcher)},
+            _cluster_gap{cluster_gap}
+        {}
+
+        //!\brief Searches the complete haystack and reports the last cluster at its end.
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) {
+            if ((*this)((haystack_t &&) haystack, 0, callback) == search_control::stop)
+                return search_control::stop;
+            return flush(callback);
+        }
+
+        /*!\brief Searches a part of a larger haystack.
+         * \param haystack The searched part.
+         * \param base_offset The position of the first symbol of the searched part within the larger haystack.
+         * \param callback The callback invoked with a spm::scored_hit for every closed cluster.
+         * \returns spm::search_control::stop if the callback stopped the search, otherwise
+         *          spm::search_control::proceed.
+         *
+         * The cluster that might still be extended by the next part stays open.
+         */
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            std::size_t const end_position = base_offset + std::ranges::size(haystack);
+            auto add_to_cluster = [&] (scored_hit const & hit) {
+                if (_cluster.has_value() && hit.end_position - _cluster->last_end_position <= _cluster_gap) {
+                    if (hit.error_count < _cluster->best_hit.error_count)
+                        _cluster->best_hit = hit;
+                    _cluster->last_end_position = hit.end_position;
+                    return search_control::proceed;
+                }
+
+                search_control const flush_control = flush(callback);
+                _cluster = cluster_type{.best_hit = hit, .last_end_position = hit.end_position};
+                return flush_control;
+            };
+
+            if (spm::scored_search(_matcher, (haystack_t &&) haystack, base_offset, add_to_cluster) ==
+                search_control::stop)
+                return search_control::stop;
+
+            // No later hit can extend the cluster.
+            if (_cluster.has_value() && end_position - _cluster->last_end_position > _cluster_gap)
+                return flush(callback);
+            return search_control::proceed;
+        }
+
+        /*!\brief Reports the open cluster, if any.
+         * \returns The spm::search_control returned by the callback or spm::search_control::proceed if no cluster
+         *          was open.
+         */
+        template <typename callback_t>
+        constexpr search_control flush(callback_t && callback) {
+            if (!_cluster.has_value())
+                return search_control::proceed;
+
+            scored_hit const best_hit = _cluster->best_hit;
+            _cluster.reset();
+            return detail::invoke_hit_callback(callback, best_hit);
+        }
+
+        constexpr matcher_t const & matcher() const noexcept {
+            return _matcher;
+        }
+
+        constexpr auto capture() const
+            requires restorable_matcher<matcher_t &>
+        {
+            return std::pair{matcher_state_t<matcher_t &>{spm::capture(_matcher)}, _cluster};
+        }
+
+        template <typename state_t>
+            requires restorable_matcher<matcher_t &>
+        constexpr void restore(state_t && state) {
+            spm::restore(_matcher, ((state_t &&) state).first);
+            _cluster = ((state_t &&) state).second;
+        }
+
+    private:
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>, clustered_matcher const & me) noexcept {
+            return spm::window_size(me._matcher);
+        }
+    };
+
+}  // namespace spm
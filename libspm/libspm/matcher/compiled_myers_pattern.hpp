@@ -0,0 +1,188 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the immutable preprocessed Myers pattern that is searched with a separate per-thread context.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/iupac_masks.hpp>
+#include <libspm/matcher/search_control.hpp>
+#include <libspm/matcher/stratified_search.hpp>
+
+namespace spm
+{
+    /*!\brief The preprocessed needle of the bit-parallel algorithm of Myers.
+     *
+     * Unlike spm::myers_matcher, the pattern holds only the needle masks, which are never modified by a search.
+     * The VP/VN state of a search lives in a separate spm::compiled_myers_pattern::context_type. Hence, a single
+     * pattern can be shared by any number of threads, each searching with its own context, e.g. through
+     * spm::contextual_matcher. The needle must fit into a single `word_t`; the search runs the recurrence of
+     * spm::fixed_length_myers_matcher on a single-word bit vector.
+     */
+    template <std::ranges::random_access_range needle_t, std::unsigned_integral word_t = uint64_t>
+    class compiled_myers_pattern
+    {
+    private:
+
+        using alphabet_type = std::ranges::range_value_t<needle_t>;
+
+        using bitvector_type = detail::fixed_bitvector<word_t, 1>;
+
+        static constexpr std::size_t word_size = bitvector_type::word_size;
+
+        std::vector<word_t> _needle_masks{};
+        word_t _needle_size{};
+        word_t _max_error_count{};
+        std::optional<iupac_matching> _iupac{};
+
+    public:
+
+        //!\brief The mutable state of a search.
+        struct context_type
+        {
+            bitvector_type vp{};
+            bitvector_type vn{};
+            word_t score{};
+
+        private:
+
+            constexpr friend bool operator==(context_type const &, context_type const &) noexcept = default;
+        };
+
+        compiled_myers_pattern() = delete;
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<std::remove_cvref_t<_needle_t>, compiled_myers_pattern>)
+        explicit compiled_myers_pattern(_needle_t && needle, std::size_t const max_error_count = 0) :
+            _needle_masks(seqan3::alphabet_size<alphabet_type>, 0)
+        {
+            rebind((_needle_t &&) needle, max_error_count);
+        }
+
+        //!\brief Constructs the pattern such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<std::remove_cvref_t<_needle_t>, compiled_myers_pattern>)
+        compiled_myers_pattern(_needle_t && needle, std::size_t const max_error_count, iupac_matching const config) :
+            _needle_masks(seqan3::alphabet_size<alphabet_type>, 0),
+            _iupac{config}
+        {
+            rebind((_needle_t &&) needle, max_error_count);
+        }
+
+        /*!\brief Replaces the needle and the maximal number of errors reusing the masks.
+         * \throws std::invalid_argument if the needle does not fit into a single `word_t`.
+         *
+         * Must not be called while the pattern is searched; existing contexts have to be reset with
+         * spm::compiled_myers_pattern::initial_context.
+         */
+        template <std::ranges::viewable_range _needle_t>
+        constexpr void rebind(_needle_t && needle, std::size_t const max_error_count) {
+            if (std::ranges::size(needle) > word_size)
+                throw std::invalid_argument{"The needle must fit into a single machine word."};
+
+            _needle_size = static_cast<word_t>(std::ranges::size(needle));
+            _max_error_count = static_cast<word_t>(max_error_count);
+            std::ranges::fill(_needle_masks, word_t{0});
+            word_t bit{1};
+            for (auto && symbol : needle) {
+                _needle_masks[seqan3::to_rank(symbol)] |= bit;
+                bit <<= 1;
+            }
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<alphabet_type>(std::span{_needle_masks}, 1, true, *_iupac);
+        }
+
+        //!\brief Replaces the needle and keeps the maximal number of errors.
+        template <std::ranges::viewable_range _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            rebind((_needle_t &&) needle, _max_error_count);
+        }
+
+        //!\brief Returns the context of a search that has not seen any symbol yet.
+        constexpr context_type initial_context() const noexcept {
+            return context_type{.vp = bitvector_type::ones(), .vn = bitvector_type{}, .score = _needle_size};
+        }
+
+        /*!\brief Searches the haystack with the given context.
+         * \param haystack The haystack to search.
+         * \param context The state of the search, which is continued and updated.
+         * \param callback The callback invoked with a spm::scored_hit for every hit.
+         */
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            context_type & context,
+                                            callback_t && callback) const {
+            return (*this)((haystack_t &&) haystack, context, 0, (callback_t &&) callback);
+        }
+
+        //!\brief Searches a part of a larger haystack starting at `base_offset` with the given context.
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            context_type & context,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) const {
+            if (_needle_size == 0)
+                return search_control::proceed;
+
+            word_t const * masks = _needle_masks.data();
+            std::size_t const last_position = _needle_size - 1;
+            std::size_t const window = spm::window_size(*this);
+            context_type state = context;
+            std::size_t end_position = base_offset;
+            search_control control{search_control::proceed};
+            for (auto && symbol : haystack) {
+                detail::myers_step(bitvector_type{.words = {masks[seqan3::to_rank(symbol)]}}, state, last_position);
+                ++end_position;
+
+                if (state.score <= _max_error_count) {
+                    control = detail::invoke_hit_callback(callback,
+                                                          scored_hit{.begin_position = end_position -
+                                                                                       std::min(end_position, window),
+                                                                     .end_position = end_position,
+                                                                     .error_count = state.score});
+                    if (control == search_control::stop)
+                        break;
+                }
+            }
+            context = state;
+            return control;
+        }
+
+    private:
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>,
+                                                compiled_myers_pattern const & me) noexcept {
+            return (me._needle_size == 0) ? 0 : me._needle_size + me._max_error_count;
+        }
+    };
+
+    template <std::ranges::viewable_range needle_t>
+    compiled_myers_pattern(needle_t &&) -> compiled_myers_pattern<std::views::all_t<needle_t>>;
+
+    template <std::ranges::viewable_range needle_t>
+    compiled_myers_pattern(needle_t &&, std::size_t) -> compiled_myers_pattern<std::views::all_t<needle_t>>;
+
+    template <std::ranges::viewable_range needle_t>
+    compiled_myers_pattern(needle_t &&, std::size_t, iupac_matching)
+        -> compiled_myers_pattern<std::views::all_t<needle_t>>;
+
+}  // namespace spm
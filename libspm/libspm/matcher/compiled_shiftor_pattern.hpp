@@ -0,0 +1,170 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the immutable preprocessed ShiftOr pattern that is searched with a separate per-thread context.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/iupac_masks.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    /*!\brief The preprocessed needle of the exact ShiftOr algorithm.
+     *
+     * The pattern holds only the symbol table, where a 0-bit marks a match as in seqan2::ShiftOr. The state of a
+     * search lives in a separate spm::compiled_shiftor_pattern::context_type, such that a single pattern can be
+     * shared by any number of threads. The needle must fit into a single `word_t`; the search runs the recurrence of
+     * spm::fixed_length_shiftor_matcher on a single-word bit vector.
+     */
+    template <std::ranges::random_access_range needle_t, std::unsigned_integral word_t = uint64_t>
+    class compiled_shiftor_pattern
+    {
+    private:
+
+        using alphabet_type = std::ranges::range_value_t<needle_t>;
+
+        using bitvector_type = detail::fixed_bitvector<word_t, 1>;
+
+        static constexpr std::size_t word_size = bitvector_type::word_size;
+
+        std::vector<word_t> _table{};
+        word_t _needle_size{};
+        std::optional<iupac_matching> _iupac{};
+
+    public:
+
+        //!\brief The mutable state of a search.
+        struct context_type
+        {
+            bitvector_type state{};
+
+        private:
+
+            constexpr friend bool operator==(context_type const &, context_type const &) noexcept = default;
+        };
+
+        compiled_shiftor_pattern() = delete;
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<std::remove_cvref_t<_needle_t>, compiled_shiftor_pattern>)
+        explicit compiled_shiftor_pattern(_needle_t && needle) :
+            _table(seqan3::alphabet_size<alphabet_type>)
+        {
+            set_needle((_needle_t &&) needle);
+        }
+
+        //!\brief Constructs the pattern such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<std::remove_cvref_t<_needle_t>, compiled_shiftor_pattern>)
+        compiled_shiftor_pattern(_needle_t && needle, iupac_matching const config) :
+            _table(seqan3::alphabet_size<alphabet_type>),
+            _iupac{config}
+        {
+            set_needle((_needle_t &&) needle);
+        }
+
+        /*!\brief Replaces the needle reusing the table.
+         * \throws std::invalid_argument if the needle does not fit into a single `word_t`.
+         *
+         * Must not be called while the pattern is searched; existing contexts have to be reset with
+         * spm::compiled_shiftor_pattern::initial_context.
+         */
+        template <std::ranges::viewable_range _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            if (std::ranges::size(needle) > word_size)
+                throw std::invalid_argument{"The needle must fit into a single machine word."};
+
+            _needle_size = static_cast<word_t>(std::ranges::size(needle));
+            std::ranges::fill(_table, static_cast<word_t>(~word_t{0}));
+            word_t bit{1};
+            for (auto && symbol : needle) {
+                _table[seqan3::to_rank(symbol)] &= static_cast<word_t>(~bit);
+                bit <<= 1;
+            }
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<alphabet_type>(std::span{_table}, 1, false, *_iupac);
+        }
+
+        //!\brief Returns the context of a search that has not seen any symbol yet.
+        constexpr context_type initial_context() const noexcept {
+            return context_type{.state = bitvector_type::ones()};
+        }
+
+        /*!\brief Searches the haystack with the given context.
+         * \param haystack The haystack to search.
+         * \param context The state of the search, which is continued and updated.
+         * \param callback The callback invoked with a spm::matcher_hit for every hit.
+         */
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            context_type & context,
+                                            callback_t && callback) const {
+            return (*this)((haystack_t &&) haystack, context, 0, (callback_t &&) callback);
+        }
+
+        //!\brief Searches a part of a larger haystack starting at `base_offset` with the given context.
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            context_type & context,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) const {
+            if (_needle_size == 0)
+                return search_control::proceed;
+
+            word_t const * table = _table.data();
+            std::size_t const last_position = _needle_size - 1;
+            bitvector_type state = context.state;
+            std::size_t end_position = base_offset;
+            search_control control{search_control::proceed};
+            for (auto && symbol : haystack) {
+                state = detail::shiftor_step(state, bitvector_type{.words = {table[seqan3::to_rank(symbol)]}});
+                ++end_position;
+
+                if (!state.test(last_position)) {
+                    control = detail::invoke_hit_callback(callback,
+                                                          matcher_hit{.begin_position = end_position - _needle_size,
+                                                                      .end_position = end_position});
+                    if (control == search_control::stop)
+                        break;
+                }
+            }
+            context.state = state;
+            return control;
+        }
+
+    private:
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>,
+                                                compiled_shiftor_pattern const & me) noexcept {
+            return me._needle_size;
+        }
+    };
+
+    template <std::ranges::viewable_range needle_t>
+    compiled_shiftor_pattern(needle_t &&) -> compiled_shiftor_pattern<std::views::all_t<needle_t>>;
+
+    template <std::ranges::viewable_range needle_t>
+    compiled_shiftor_pattern(needle_t &&, iupac_matching) -> compiled_shiftor_pattern<std::views::all_t<needle_t>>;
+
+}  // namespace spm
@@ -13,6 +13,8 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
+#include <ranges>
 #include <type_traits>
 
 #include <libspm/std/tag_invoke.hpp>
@@ -119,6 +121,69 @@ namespace spm
     } // namespace _aggregate
     using _aggregate::aggregate;
 
+    // count
+    namespace _count {
+        inline constexpr struct _cpo  {
+            /*!\brief Returns the number of hits of the matcher in the haystack.
+             *
+             * Matchers can customise the query to avoid the construction of a hit per occurrence. Otherwise, the hits
+             * reported to a counting callback are counted.
+             */
+            template <typename matcher_t, typename haystack_t>
+            constexpr std::size_t operator()(matcher_t && matcher, haystack_t && haystack) const {
+                if constexpr (std::tag_invocable<_cpo, matcher_t, haystack_t>) {
+                    return std::tag_invoke(_cpo{}, (matcher_t &&) matcher, (haystack_t &&) haystack);
+                } else {
+                    std::size_t hit_count{};
+                    ((matcher_t &&) matcher)((haystack_t &&) haystack, [&] (auto const &) { ++hit_count; });
+                    return hit_count;
+                }
+            }
+        } count;
+    } // namespace _count
+    using _count::count;
+
+    // contains
+    namespace _contains {
+        inline constexpr struct _cpo  {
+            /*!\brief Returns whether the matcher has at least one hit in the haystack.
+             *
+             * Matchers can customise the query to stop at the first hit. Otherwise, the complete haystack is searched.
+             */
+            template <typename matcher_t, typename haystack_t>
+            constexpr bool operator()(matcher_t && matcher, haystack_t && haystack) const {
+                if constexpr (std::tag_invocable<_cpo, matcher_t, haystack_t>) {
+                    return std::tag_invoke(_cpo{}, (matcher_t &&) matcher, (haystack_t &&) haystack);
+                } else {
+                    bool found{false};
+                    ((matcher_t &&) matcher)((haystack_t &&) haystack, [&] (auto const &) { found = true; });
+                    return found;
+                }
+            }
+        } contains;
+    } // namespace _contains
+    using _contains::contains;
+
+    // search
+    namespace _search {
+        inline constexpr struct _cpo  {
+            /*!\brief Returns a lazy input range over the hits of the matcher in the haystack.
+             *
+             * The hits are computed on demand while the range is iterated. The matcher and the haystack must outlive
+             * the returned range.
+             */
+            template <typename matcher_t, typename haystack_t>
+                requires std::tag_invocable<_cpo, matcher_t, haystack_t>
+            constexpr auto operator()(matcher_t && matcher, haystack_t && haystack) const
+                noexcept(std::is_nothrow_tag_invocable_v<_cpo, matcher_t, haystack_t>)
+                -> std::tag_invoke_result_t<_cpo, matcher_t, haystack_t>
+            {
+                return std::tag_invoke(_cpo{}, (matcher_t &&) matcher, (haystack_t &&) haystack);
+            }
+        } search;
+    } // namespace _search
+    using _search::search;
+
     // ----------------------------------------------------------------------------
     // Concept defintions for matcher
     // ----------------------------------------------------------------------------
@@ -157,6 +222,12 @@ namespace spm
     template <typename state_t>
     concept reducable_state = reducable_with<state_t, state_t>;
 
+    //!\brief A haystack made of several segments, e.g. the buffers of a reader, that are searched as one sequence.
+    template <typename haystack_t>
+    concept segmented_haystack = std::ranges::input_range<haystack_t> &&
+                                 std::ranges::random_access_range<std::ranges::range_reference_t<haystack_t>> &&
+                                 std::ranges::sized_range<std::ranges::range_reference_t<haystack_t>>;
+
     template <typename matcher_t, typename ...args_t>
     concept online_matcher_for = window_matcher<matcher_t> && std::invocable<matcher_t, args_t...>;
 }  // namespace spm
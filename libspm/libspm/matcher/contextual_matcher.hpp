@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a lightweight matcher binding a shared compiled pattern to its own search context.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    //!\brief An immutable pattern that is searched with an explicit, separately stored context.
+    template <typename pattern_t>
+    concept compiled_pattern = requires (pattern_t const & pattern)
+    {
+        typename pattern_t::context_type;
+        requires std::semiregular<typename pattern_t::context_type>;
+        { pattern.initial_context() } -> std::same_as<typename pattern_t::context_type>;
+        { spm::window_size(pattern) } -> std::integral;
+    };
+
+    /*!\brief Searches a shared compiled pattern with its own context.
+     * \tparam pattern_t The type of the pattern modelling spm::compiled_pattern, e.g. spm::compiled_myers_pattern.
+     *
+     * The matcher shares ownership of the immutable pattern and owns only the context of the search. Thus, copying the
+     * matcher, e.g. for every thread or every bin of spm::parallel_jst_search, copies the context but never the
+     * preprocessed needle. The context is the state of the matcher, such that the matcher models
+     * spm::restorable_matcher.
+     */
+    template <compiled_pattern pattern_t>
+    class contextual_matcher
+    {
+    public:
+
+        using context_type = typename pattern_t::context_type;
+
+    private:
+
+        std::shared_ptr<pattern_t const> _pattern{};
+        context_type _context{};
+
+    public:
+
+        contextual_matcher() = delete;
+        //!\brief Constructs the matcher from a pattern shared with other matchers.
+        explicit contextual_matcher(std::shared_ptr<pattern_t const> pattern) noexcept :
+            _pattern{std::move(pattern)}
+        {
+            assert(_pattern != nullptr);
+            _context = _pattern->initial_context();
+        }
+
+        //!\brief Constructs the matcher taking ownership of the pattern, which is shared with all copies of the matcher.
+        explicit contextual_matcher(pattern_t pattern) :
+            contextual_matcher{std::make_shared<pattern_t const>(std::move(pattern))}
+        {}
+
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) {
+            return (*_pattern)((haystack_t &&) haystack, _context, (callback_t &&) callback);
+        }
+
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            return (*_pattern)((haystack_t &&) haystack, _context, base_offset, (callback_t &&) callback);
+        }
+
+        constexpr pattern_t const & pattern() const noexcept {
+            return *_pattern;
+        }
+
+        constexpr context_type capture() const noexcept {
+            return _context;
+        }
+
+        constexpr void restore(context_type const & context) noexcept {
+            _context = context;
+        }
+
+    private:
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>, contextual_matcher const & me) noexcept {
+            return spm::window_size(*me._pattern);
+        }
+    };
+
+    template <typename pattern_t>
+    contextual_matcher(std::shared_ptr<pattern_t>) -> contextual_matcher<std::remove_const_t<pattern_t>>;
+
+}  // namespace spm
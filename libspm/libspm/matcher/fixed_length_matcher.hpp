@@ -0,0 +1,427 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bit-parallel matchers whose needle length is bounded at compile time.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/core/concept/cereal.hpp>
+
+#if SEQAN3_WITH_CEREAL
+#include <cereal/types/array.hpp>
+#endif
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    namespace detail
+    {
+        //!\brief A bit vector of a fixed number of words supporting the arithmetic of the bit-parallel algorithms.
+        template <std::unsigned_integral word_t, std::size_t word_count>
+        struct fixed_bitvector
+        {
+            static constexpr std::size_t word_size = std::numeric_limits<word_t>::digits;
+
+            std::array<word_t, word_count> words{};
+
+            static constexpr fixed_bitvector ones() noexcept {
+                fixed_bitvector result{};
+                result.words.fill(static_cast<word_t>(~word_t{0}));
+                return result;
+            }
+
+            constexpr bool test(std::size_t const position) const noexcept {
+                return (words[position / word_size] >> (position % word_size)) & 1;
+            }
+
+            constexpr void set(std::size_t const position) noexcept {
+                words[position / word_size] |= word_t{1} << (position % word_size);
+            }
+
+            constexpr void reset(std::size_t const position) noexcept {
+                words[position / word_size] &= static_cast<word_t>(~(word_t{1} << (position % word_size)));
+            }
+
+            //!\brief Shifts all bits by one position towards the most significant bit.
+            constexpr fixed_bitvector shift_left() const noexcept {
+                fixed_bitvector result{};
+                word_t carry{};
+                for (std::size_t word = 0; word < word_count; ++word) {
+                    result.words[word] = static_cast<word_t>(words[word] << 1) | carry;
+                    carry = words[word] >> (word_size - 1);
+                }
+                return result;
+            }
+
+            constexpr friend fixed_bitvector operator+(fixed_bitvector const & lhs, fixed_bitvector const & rhs) noexcept {
+                fixed_bitvector result{};
+                word_t carry{};
+                for (std::size_t word = 0; word < word_count; ++word) {
+                    word_t const sum = lhs.words[word] + rhs.words[word];
+                    result.words[word] = sum + carry;
+                    carry = (sum < lhs.words[word]) | (result.words[word] < sum);
+                }
+                return result;
+            }
+
+            constexpr friend fixed_bitvector operator&(fixed_bitvector const & lhs, fixed_bitvector const & rhs) noexcept {
+                return transform(lhs, rhs, [] (word_t const a, word_t const b) { return a & b; });
+            }
+
+            constexpr friend fixed_bitvector operator|(fixed_bitvector const & lhs, fixed_bitvector const & rhs) noexcept {
+                return transform(lhs, rhs, [] (word_t const a, word_t const b) { return a | b; });
+            }
+
+            constexpr friend fixed_bitvector operator^(fixed_bitvector const & lhs, fixed_bitvector const & rhs) noexcept {
+                return transform(lhs, rhs, [] (word_t const a, word_t const b) { return a ^ b; });
+            }
+
+            constexpr friend fixed_bitvector operator~(fixed_bitvector const & operand) noexcept {
+                return transform(operand, operand, [] (word_t const a, word_t) { return static_cast<word_t>(~a); });
+            }
+
+            template <seqan3::cereal_archive archive_t>
+            void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+                archive(words);
+            }
+
+        private:
+
+            template <typename operation_t>
+            static constexpr fixed_bitvector transform(fixed_bitvector const & lhs,
+                                                       fixed_bitvector const & rhs,
+                                                       operation_t && operation) noexcept {
+                fixed_bitvector result{};
+                for (std::size_t word = 0; word < word_count; ++word)
+                    result.words[word] = operation(lhs.words[word], rhs.words[word]);
+                return result;
+            }
+
+            constexpr friend bool operator==(fixed_bitvector const &, fixed_bitvector const &) noexcept = default;
+        };
+
+        //!\brief The bit vector holding needles of up to `max_needle_size` symbols in as few words as possible.
+        template <std::size_t max_needle_size>
+        using fixed_bitvector_for = std::conditional_t<(max_needle_size <= 32),
+                                                       fixed_bitvector<uint32_t, 1>,
+                                                       fixed_bitvector<uint64_t, (max_needle_size + 63) / 64>>;
+
+        //!\brief Advances the ShiftOr state by one haystack symbol, whose table entry is `mask`.
+        template <typename bitvector_t>
+        constexpr bitvector_t shiftor_step(bitvector_t const & state, bitvector_t const & mask) noexcept {
+            return state.shift_left() | mask;
+        }
+
+        /*!\brief Advances the state of the bit-parallel algorithm of Myers by one haystack symbol.
+         * \param eq The needle mask of the haystack symbol.
+         * \param state The state with the vertical delta vectors `vp` and `vn` and the `score` of the last needle
+         *              position, which is updated.
+         * \param last_position The position of the last needle symbol in the bit vectors.
+         */
+        template <typename bitvector_t, typename state_t>
+        constexpr void myers_step(bitvector_t const & eq, state_t & state, std::size_t const last_position) noexcept {
+            bitvector_t const xv = eq | state.vn;
+            bitvector_t const xh = (((eq & state.vp) + state.vp) ^ state.vp) | eq;
+            bitvector_t hp = state.vn | ~(xh | state.vp);
+            bitvector_t hn = state.vp & xh;
+            state.score += hp.test(last_position);
+            state.score -= hn.test(last_position);
+            hp = hp.shift_left();
+            hn = hn.shift_left();
+            state.vp = hn | ~(xv | hp);
+            state.vn = hp & xv;
+        }
+    } // namespace detail
+
+    /*!\brief The ShiftOr matcher for needles of at most `max_needle_size` symbols.
+     * \tparam max_needle_size The compile-time bound of the needle length.
+     * \tparam alphabet_t The alphabet of the needle and the haystack.
+     *
+     * The symbol table and the state are stored inline in fixed-size arrays. Hence, the matcher never allocates, the
+     * loops over the words of the bit vectors have a compile-time trip count and the state is trivially copyable.
+     * The matcher is restorable and reports a spm::matcher_hit for every occurrence.
+     */
+    template <std::size_t max_needle_size, typename alphabet_t>
+    class fixed_length_shiftor_matcher
+    {
+    private:
+
+        static_assert(max_needle_size > 0, "The needle length bound must be positive.");
+
+        using bitvector_type = detail::fixed_bitvector_for<max_needle_size>;
+
+        std::array<bitvector_type, seqan3::alphabet_size<alphabet_t>> _table{};
+        bitvector_type _state{bitvector_type::ones()};
+        std::size_t _needle_size{};
+
+    public:
+
+        using state_type = bitvector_type;
+
+        fixed_length_shiftor_matcher() = delete;
+        template <std::ranges::viewable_range needle_t>
+            requires (!std::same_as<std::remove_cvref_t<needle_t>, fixed_length_shiftor_matcher>)
+        explicit fixed_length_shiftor_matcher(needle_t && needle) {
+            set_needle((needle_t &&) needle);
+        }
+
+        /*!\brief Replaces the needle and resets the state.
+         * \throws std::invalid_argument if the needle is longer than `max_needle_size`.
+         */
+        template <std::ranges::viewable_range needle_t>
+        constexpr void set_needle(needle_t && needle) {
+            if (std::ranges::size(needle) > max_needle_size)
+                throw std::invalid_argument{"The needle exceeds the length bound of the fixed-length matcher."};
+
+            _needle_size = std::ranges::size(needle);
+            _table.fill(bitvector_type::ones());
+            std::size_t position{};
+            for (auto && symbol : needle)
+                _table[seqan3::to_rank(symbol)].reset(position++);
+            _state = bitvector_type::ones();
+        }
+
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) {
+            return (*this)((haystack_t &&) haystack, 0, (callback_t &&) callback);
+        }
+
+        //!\brief Searches a part of a larger haystack starting at `base_offset`.
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            if (_needle_size == 0)
+                return search_control::proceed;
+
+            std::size_t const last_position = _needle_size - 1;
+            std::size_t end_position = base_offset;
+            for (auto && symbol : haystack) {
+                _state = detail::shiftor_step(_state, _table[seqan3::to_rank(symbol)]);
+                ++end_position;
+
+                if (!_state.test(last_position) &&
+                    detail::invoke_hit_callback(callback,
+                                                matcher_hit{.begin_position = end_position - _needle_size,
+                                                            .end_position = end_position}) == search_control::stop)
+                    return search_control::stop;
+            }
+            return search_control::proceed;
+        }
+
+        constexpr state_type capture() const noexcept {
+            return _state;
+        }
+
+        constexpr void restore(state_type const & state) noexcept {
+            _state = state;
+        }
+
+        //!\brief Serialises the needle table and the state of the matcher.
+        template <seqan3::cereal_archive archive_t>
+        void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+            archive(_table, _state, _needle_size);
+        }
+
+    private:
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>,
+                                                fixed_length_shiftor_matcher const & me) noexcept {
+            return me._needle_size;
+        }
+    };
+
+    /*!\brief The bit-parallel Myers matcher for needles of at most `max_needle_size` symbols.
+     * \tparam max_needle_size The compile-time bound of the needle length.
+     * \tparam alphabet_t The alphabet of the needle and the haystack.
+     *
+     * Needles longer than a machine word are handled as one wide bit vector instead of separate blocks. The masks and
+     * the state are stored inline in fixed-size arrays, such that the matcher never allocates and the state is
+     * trivially copyable. The matcher is restorable and reports a spm::matcher_hit for every end position with at most
+     * the given number of errors, which are available through spm::fixed_length_myers_matcher::error_count.
+     */
+    template <std::size_t max_needle_size, typename alphabet_t>
+    class fixed_length_myers_matcher
+    {
+    private:
+
+        static_assert(max_needle_size > 0, "The needle length bound must be positive.");
+
+        using bitvector_type = detail::fixed_bitvector_for<max_needle_size>;
+
+    public:
+
+        //!\brief The state of the search.
+        struct state_type
+        {
+            bitvector_type vp{};
+            bitvector_type vn{};
+            std::size_t score{};
+
+            template <seqan3::cereal_archive archive_t>
+            void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+                archive(vp, vn, score);
+            }
+
+        private:
+
+            constexpr friend bool operator==(state_type const &, state_type const &) noexcept = default;
+        };
+
+    private:
+
+        std::array<bitvector_type, seqan3::alphabet_size<alphabet_t>> _masks{};
+        state_type _state{};
+        std::size_t _needle_size{};
+        std::size_t _max_error_count{};
+
+    public:
+
+        fixed_length_myers_matcher() = delete;
+        template <std::ranges::viewable_range needle_t>
+            requires (!std::same_as<std::remove_cvref_t<needle_t>, fixed_length_myers_matcher>)
+        explicit fixed_length_myers_matcher(needle_t && needle, std::size_t const max_error_count = 0) {
+            rebind((needle_t &&) needle, max_error_count);
+        }
+
+        /*!\brief Replaces the needle and the maximal number of errors and resets the state.
+         * \throws std::invalid_argument if the needle is longer than `max_needle_size`.
+         */
+        template <std::ranges::viewable_range needle_t>
+        constexpr void rebind(needle_t && needle, std::size_t const max_error_count) {
+            if (std::ranges::size(needle) > max_needle_size)
+                throw std::invalid_argument{"The needle exceeds the length bound of the fixed-length matcher."};
+
+            _needle_size = std::ranges::size(needle);
+            _max_error_count = max_error_count;
+            _masks.fill(bitvector_type{});
+            std::size_t position{};
+            for (auto && symbol : needle)
+                _masks[seqan3::to_rank(symbol)].set(position++);
+            _state = state_type{.vp = bitvector_type::ones(), .vn = bitvector_type{}, .score = _needle_size};
+        }
+
+        //!\brief Replaces the needle, keeps the maximal number of errors and resets the state.
+        template <std::ranges::viewable_range needle_t>
+        constexpr void set_needle(needle_t && needle) {
+            rebind((needle_t &&) needle, _max_error_count);
+        }
+
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) {
+            return (*this)((haystack_t &&) haystack, 0, (callback_t &&) callback);
+        }
+
+        //!\brief Searches a part of a larger haystack starting at `base_offset`.
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            if (_needle_size == 0)
+                return search_control::proceed;
+
+            std::size_t const last_position = _needle_size - 1;
+            std::size_t const window = spm::window_size(*this);
+            std::size_t end_position = base_offset;
+            for (auto && symbol : haystack) {
+                detail::myers_step(_masks[seqan3::to_rank(symbol)], _state, last_position);
+                ++end_position;
+
+                if (_state.score <= _max_error_count &&
+                    detail::invoke_hit_callback(callback,
+                                                matcher_hit{.begin_position = end_position - std::min(end_position, window),
+                                                            .end_position = end_position}) == search_control::stop)
+                    return search_control::stop;
+            }
+            return search_control::proceed;
+        }
+
+        //!\brief The number of errors of the last reported hit, i.e. to be called from within the callback.
+        constexpr std::size_t error_count() const noexcept {
+            return _state.score;
+        }
+
+        constexpr state_type capture() const noexcept {
+            return _state;
+        }
+
+        constexpr void restore(state_type const & state) noexcept {
+            _state = state;
+        }
+
+        //!\brief Serialises the needle masks, the maximal number of errors and the state of the matcher.
+        template <seqan3::cereal_archive archive_t>
+        void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+            archive(_masks, _state, _needle_size, _max_error_count);
+        }
+
+    private:
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>,
+                                                fixed_length_myers_matcher const & me) noexcept {
+            return (me._needle_size == 0) ? 0 : me._needle_size + me._max_error_count;
+        }
+    };
+
+    //!\brief The needle length bounds for which spm::visit_fixed_length_matcher instantiates a matcher.
+    inline constexpr std::array<std::size_t, 4> fixed_length_buckets{32, 64, 128, 256};
+
+    /*!\brief Constructs the fixed-length matcher with the smallest bound fitting the needle and passes it to the visitor.
+     * \tparam fixed_length_matcher_t The matcher template, e.g. spm::fixed_length_myers_matcher.
+     * \param visitor The callable invoked with the constructed matcher.
+     * \param needle The needle.
+     * \param args Further arguments to construct the matcher with, e.g. the maximal number of errors.
+     * \returns `false` if the needle is longer than the largest of spm::fixed_length_buckets, in which case the
+     *          visitor is not invoked and a matcher with a runtime needle length has to be used instead.
+     *
+     * Since the read length is fixed per run, the dispatch happens once and the search runs the specialised kernel.
+     */
+    template <template <std::size_t, typename> typename fixed_length_matcher_t,
+              typename visitor_t,
+              std::ranges::viewable_range needle_t,
+              typename ...args_t>
+    bool visit_fixed_length_matcher(visitor_t && visitor, needle_t && needle, args_t && ...args) {
+        using alphabet_t = std::ranges::range_value_t<needle_t>;
+
+        std::size_t const needle_size = std::ranges::size(needle);
+        auto visit_bucket = [&] <std::size_t bucket_index> (std::integral_constant<std::size_t, bucket_index>) {
+            if constexpr (bucket_index == fixed_length_buckets.size()) {
+                return false;
+            } else {
+                constexpr std::size_t max_needle_size = fixed_length_buckets[bucket_index];
+                if (needle_size > max_needle_size)
+                    return false;
+
+                fixed_length_matcher_t<max_needle_size, alphabet_t> matcher(needle, (args_t &&) args...);
+                visitor(matcher);
+                return true;
+            }
+        };
+
+        return visit_bucket(std::integral_constant<std::size_t, 0>{}) ||
+               visit_bucket(std::integral_constant<std::size_t, 1>{}) ||
+               visit_bucket(std::integral_constant<std::size_t, 2>{}) ||
+               visit_bucket(std::integral_constant<std::size_t, 3>{});
+    }
+
+}  // namespace spm
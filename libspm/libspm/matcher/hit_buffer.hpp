@@ -0,0 +1,324 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a columnar sink for hits, the block-wise flushing of per-thread buffers and their ordered merge.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace spm
+{
+    //!\brief A hit of a needle in a haystack as stored by spm::hit_buffer.
+    struct hit_record
+    {
+        std::size_t needle_id{}; //!< The id of the needle.
+        std::size_t haystack_id{}; //!< The id of the haystack.
+        std::size_t begin_position{}; //!< The begin position of the hit.
+        std::size_t end_position{}; //!< The end position of the hit (exclusive).
+        std::ptrdiff_t score{}; //!< The score of the hit, i.e. the negated number of errors for approximate hits.
+
+    private:
+
+        constexpr friend bool operator==(hit_record const &, hit_record const &) noexcept = default;
+    };
+
+    /*!\brief Stores hits column-wise, i.e. every member of spm::hit_record in its own contiguous array.
+     *
+     * The buffer is the sink of the hit callbacks: spm::hit_buffer::sink returns a callback that appends every
+     * reported spm::matcher_hit, spm::scored_hit or any other hit with a begin and an end position. Sorting and
+     * deduplication downstream then scan the few columns they need instead of a vector of structs.
+     *
+     * The buffers are ordered by haystack id, end position, begin position, needle id and score, in this order.
+     * Buffers sorted with spm::hit_buffer::sort, e.g. the buffers of several threads, can be merged with
+     * spm::merge_hit_buffers.
+     */
+    class hit_buffer
+    {
+    private:
+
+        using sort_key_type = std::tuple<std::size_t, std::size_t, std::size_t, std::size_t, std::ptrdiff_t>;
+
+        std::vector<std::size_t> _needle_ids{};
+        std::vector<std::size_t> _haystack_ids{};
+        std::vector<std::size_t> _begin_positions{};
+        std::vector<std::size_t> _end_positions{};
+        std::vector<std::ptrdiff_t> _scores{};
+
+    public:
+
+        hit_buffer() = default;
+
+        //!\brief Returns the hit at the given position.
+        hit_record operator[](std::size_t const index) const noexcept {
+            assert(index < size());
+            return hit_record{.needle_id = _needle_ids[index],
+                              .haystack_id = _haystack_ids[index],
+                              .begin_position = _begin_positions[index],
+                              .end_position = _end_positions[index],
+                              .score = _scores[index]};
+        }
+
+        void push_back(hit_record const & hit) {
+            _needle_ids.push_back(hit.needle_id);
+            _haystack_ids.push_back(hit.haystack_id);
+            _begin_positions.push_back(hit.begin_position);
+            _end_positions.push_back(hit.end_position);
+            _scores.push_back(hit.score);
+        }
+
+        //!\brief Appends all hits of the other buffer.
+        void append(hit_buffer const & other) {
+            auto append_column = [] (auto & column, auto const & other_column) {
+                column.insert(column.end(), other_column.begin(), other_column.end());
+            };
+            append_column(_needle_ids, other._needle_ids);
+            append_column(_haystack_ids, other._haystack_ids);
+            append_column(_begin_positions, other._begin_positions);
+            append_column(_end_positions, other._end_positions);
+            append_column(_scores, other._scores);
+        }
+
+        /*!\brief Returns a callback storing the reported hits of the given needle in the given haystack.
+         *
+         * The callback accepts any hit with a `begin_position` and an `end_position`. If the hit has an
+         * `error_count`, e.g. spm::scored_hit, the score is set to the negated number of errors.
+         */
+        auto sink(std::size_t const needle_id, std::size_t const haystack_id = 0) noexcept {
+            return [this, needle_id, haystack_id] (auto const & hit) {
+                std::ptrdiff_t score{};
+                if constexpr (requires { hit.error_count; })
+                    score = -static_cast<std::ptrdiff_t>(hit.error_count);
+
+                push_back(hit_record{.needle_id = needle_id,
+                                     .haystack_id = haystack_id,
+                                     .begin_position = hit.begin_position,
+                                     .end_position = hit.end_position,
+                                     .score = score});
+            };
+        }
+
+        //!\brief Sorts the hits by haystack id, end position, begin position, needle id and score.
+        void sort() {
+            std::vector<std::size_t> order(size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::sort(order, std::less<>{}, [&] (std::size_t const index) { return sort_key(index); });
+
+            auto permute = [&] (auto & column) {
+                std::remove_reference_t<decltype(column)> permuted(column.size());
+                std::ranges::transform(order, permuted.begin(), [&] (std::size_t const index) {
+                    return column[index];
+                });
+                column = std::move(permuted);
+            };
+            permute(_needle_ids);
+            permute(_haystack_ids);
+            permute(_begin_positions);
+            permute(_end_positions);
+            permute(_scores);
+        }
+
+        //!\brief Removes consecutive duplicates, i.e. all duplicates if the buffer is sorted.
+        void unique() {
+            std::size_t kept{};
+            for (std::size_t index = 0; index < size(); ++index) {
+                if (kept > 0 && sort_key(kept - 1) == sort_key(index))
+                    continue;
+
+                _needle_ids[kept] = _needle_ids[index];
+                _haystack_ids[kept] = _haystack_ids[index];
+                _begin_positions[kept] = _begin_positions[index];
+                _end_positions[kept] = _end_positions[index];
+                _scores[kept] = _scores[index];
+                ++kept;
+            }
+            resize(kept);
+        }
+
+        void reserve(std::size_t const capacity) {
+            _needle_ids.reserve(capacity);
+            _haystack_ids.reserve(capacity);
+            _begin_positions.reserve(capacity);
+            _end_positions.reserve(capacity);
+            _scores.reserve(capacity);
+        }
+
+        void clear() noexcept {
+            _needle_ids.clear();
+            _haystack_ids.clear();
+            _begin_positions.clear();
+            _end_positions.clear();
+            _scores.clear();
+        }
+
+        std::size_t size() const noexcept {
+            return _end_positions.size();
+        }
+
+        bool empty() const noexcept {
+            return _end_positions.empty();
+        }
+
+        //!\name Columns
+        //!\{
+        std::span<std::size_t const> needle_ids() const noexcept {
+            return _needle_ids;
+        }
+
+        std::span<std::size_t const> haystack_ids() const noexcept {
+            return _haystack_ids;
+        }
+
+        std::span<std::size_t const> begin_positions() const noexcept {
+            return _begin_positions;
+        }
+
+        std::span<std::size_t const> end_positions() const noexcept {
+            return _end_positions;
+        }
+
+        std::span<std::ptrdiff_t const> scores() const noexcept {
+            return _scores;
+        }
+        //!\}
+
+    private:
+
+        void resize(std::size_t const new_size) {
+            _needle_ids.resize(new_size);
+            _haystack_ids.resize(new_size);
+            _begin_positions.resize(new_size);
+            _end_positions.resize(new_size);
+            _scores.resize(new_size);
+        }
+
+        sort_key_type sort_key(std::size_t const index) const noexcept {
+            return sort_key_type{_haystack_ids[index],
+                              _end_positions[index],
+                              _begin_positions[index],
+                              _needle_ids[index],
+                              _scores[index]};
+        }
+
+        friend hit_buffer merge_hit_buffers(std::span<hit_buffer const>);
+    };
+
+    /*!\brief Collects the hits of one thread and hands them over in blocks.
+     * \tparam flush_callback_t The type of the callback invoked with every full block, e.g. appending it under a lock
+     *                          to a shared spm::hit_buffer.
+     *
+     * The thread-local block is flushed whenever it holds `block_size` hits, when spm::hit_block_writer::flush is
+     * called and on destruction, such that the synchronisation is paid once per block rather than once per hit.
+     * An exception thrown by the flush callback on destruction terminates the program; call
+     * spm::hit_block_writer::flush explicitly to handle it. The writer can neither be copied nor moved since the
+     * callbacks returned by spm::hit_block_writer::sink refer to it.
+     */
+    template <typename flush_callback_t>
+    class hit_block_writer
+    {
+    private:
+
+        hit_buffer _block{};
+        std::size_t _block_size{};
+        flush_callback_t _flush_callback;
+
+    public:
+
+        hit_block_writer() = delete;
+        hit_block_writer(std::size_t const block_size, flush_callback_t flush_callback) :
+            _block_size{std::max<std::size_t>(block_size, 1)},
+            _flush_callback{std::move(flush_callback)}
+        {
+            _block.reserve(_block_size);
+        }
+
+        hit_block_writer(hit_block_writer const &) = delete;
+        hit_block_writer(hit_block_writer &&) = delete;
+        hit_block_writer & operator=(hit_block_writer const &) = delete;
+        hit_block_writer & operator=(hit_block_writer &&) = delete;
+
+        //!\brief Hands over the remaining hits.
+        ~hit_block_writer() {
+            flush();
+        }
+
+        void push_back(hit_record const & hit) {
+            _block.push_back(hit);
+            if (_block.size() >= _block_size)
+                flush();
+        }
+
+        //!\brief Returns a callback storing the reported hits of the given needle in the given haystack.
+        auto sink(std::size_t const needle_id, std::size_t const haystack_id = 0) noexcept {
+            return [this, sink = _block.sink(needle_id, haystack_id)] (auto const & hit) mutable {
+                sink(hit);
+                if (_block.size() >= _block_size)
+                    flush();
+            };
+        }
+
+        //!\brief Hands over the collected hits, if any.
+        void flush() {
+            if (!_block.empty()) {
+                _flush_callback(std::as_const(_block));
+                _block.clear();
+            }
+        }
+    };
+
+    /*!\brief Merges sorted buffers into a single sorted buffer.
+     * \param buffers The buffers, each sorted by spm::hit_buffer::sort.
+     *
+     * Performs a k-way merge over the sort keys of the buffers using a heap of the current heads of the buffers.
+     * Hits with equal keys are taken from the buffers in the given order.
+     */
+    inline hit_buffer merge_hit_buffers(std::span<hit_buffer const> buffers) {
+        using cursor_t = std::pair<std::size_t, std::size_t>; // buffer and position within the buffer.
+
+        hit_buffer merged{};
+        std::size_t total_size{};
+        for (hit_buffer const & buffer : buffers)
+            total_size += buffer.size();
+        merged.reserve(total_size);
+
+        // Min-heap ordered by the key of the head of the buffer and then by the buffer index.
+        auto greater = [&] (cursor_t const & lhs, cursor_t const & rhs) {
+            return std::tuple{buffers[lhs.first].sort_key(lhs.second), lhs.first} >
+                   std::tuple{buffers[rhs.first].sort_key(rhs.second), rhs.first};
+        };
+
+        std::vector<cursor_t> heads{};
+        for (std::size_t buffer = 0; buffer < buffers.size(); ++buffer)
+            if (!buffers[buffer].empty())
+                heads.emplace_back(buffer, 0);
+        std::ranges::make_heap(heads, greater);
+
+        while (!heads.empty()) {
+            std::ranges::pop_heap(heads, greater);
+            auto & [buffer, position] = heads.back();
+            merged.push_back(buffers[buffer][position]);
+            if (++position < buffers[buffer].size())
+                std::ranges::push_heap(heads, greater);
+            else
+                heads.pop_back();
+        }
+        return merged;
+    }
+
+}  // namespace spm
@@ -38,6 +38,16 @@ namespace spm
         explicit horspool_matcher(_needle_t && needle) :
             _pattern{spm::make_seqan_container(std::views::all((_needle_t &&) needle))}
         {}
+
+        /*!\brief Replaces the needle without constructing a new matcher.
+         *
+         * The new needle must be convertible to the needle type of the matcher.
+         */
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            seqan2::setHost(_pattern, spm::make_seqan_container(needle_t{(_needle_t &&) needle}));
+        }
     };
 
     template <std::ranges::viewable_range needle_t>
@@ -0,0 +1,126 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the IUPAC compatible construction of the symbol masks of the bit-parallel matchers.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+
+namespace spm
+{
+    //!\brief Determines whether an `N` in the haystack matches every needle symbol or none.
+    enum class haystack_n_policy
+    {
+        mismatch, //!< A haystack `N` is never a match.
+        match //!< A haystack `N` matches every needle symbol.
+    };
+
+    /*!\brief Enables the degenerate matching of IUPAC symbols in the bit-parallel matchers.
+     *
+     * A needle symbol matches a haystack symbol if it covers all bases the haystack symbol stands for, e.g. the needle
+     * symbol `R` matches the haystack symbols `A`, `G` and `R` but a needle `A` does not match a haystack `R`.
+     * The haystack symbol `N` is handled by the configured spm::haystack_n_policy.
+     * The compatibility is folded into the per-symbol masks of the matcher, such that the search itself is unchanged.
+     */
+    struct iupac_matching
+    {
+        haystack_n_policy haystack_n{haystack_n_policy::mismatch}; //!< The handling of an `N` in the haystack.
+
+    private:
+
+        constexpr friend bool operator==(iupac_matching const &, iupac_matching const &) noexcept = default;
+    };
+
+    namespace detail
+    {
+        //!\brief Returns the set of bases {A = 1, C = 2, G = 4, T = 8} represented by an IUPAC character.
+        constexpr uint8_t iupac_bases(char const symbol) noexcept {
+            switch (symbol) {
+                case 'A': case 'a': return 0b0001;
+                case 'C': case 'c': return 0b0010;
+                case 'G': case 'g': return 0b0100;
+                case 'T': case 't': case 'U': case 'u': return 0b1000;
+                case 'M': case 'm': return 0b0011;
+                case 'R': case 'r': return 0b0101;
+                case 'W': case 'w': return 0b1001;
+                case 'S': case 's': return 0b0110;
+                case 'Y': case 'y': return 0b1010;
+                case 'K': case 'k': return 0b1100;
+                case 'V': case 'v': return 0b0111;
+                case 'H': case 'h': return 0b1011;
+                case 'D': case 'd': return 0b1101;
+                case 'B': case 'b': return 0b1110;
+                case 'N': case 'n': return 0b1111;
+                default: return 0;
+            }
+        }
+
+        template <seqan3::writable_alphabet alphabet_t>
+        constexpr uint8_t iupac_bases_of_rank(std::size_t const rank) noexcept {
+            using rank_t = seqan3::alphabet_rank_t<alphabet_t>;
+            return iupac_bases(seqan3::to_char(seqan3::assign_rank_to(static_cast<rank_t>(rank), alphabet_t{})));
+        }
+
+        //!\brief Whether the needle symbol with rank `needle_rank` matches the haystack symbol with `haystack_rank`.
+        template <seqan3::writable_alphabet alphabet_t>
+        constexpr bool iupac_compatible(std::size_t const needle_rank,
+                                        std::size_t const haystack_rank,
+                                        iupac_matching const config) noexcept {
+            uint8_t const needle_bases = iupac_bases_of_rank<alphabet_t>(needle_rank);
+            uint8_t const haystack_bases = iupac_bases_of_rank<alphabet_t>(haystack_rank);
+
+            if (haystack_bases == 0b1111)
+                return config.haystack_n == haystack_n_policy::match;
+            if (haystack_bases == 0)
+                return needle_rank == haystack_rank;
+            return (needle_bases & haystack_bases) == haystack_bases;
+        }
+
+        /*!\brief Folds the IUPAC compatibility into the per-symbol masks of a bit-parallel matcher.
+         * \param masks The masks stored as `alphabet_size * block_count` words, where the word of block `b` for the
+         *              symbol with rank `r` is at `r * block_count + b`. Additional trailing words are not modified.
+         * \param block_count The number of words per symbol.
+         * \param match_bit The value of a bit marking a match, i.e. `true` for Myers and `false` for ShiftOr.
+         * \param config The configuration of the IUPAC matching.
+         *
+         * The mask of a haystack symbol becomes the union of the matches of all compatible needle symbols.
+         */
+        template <seqan3::writable_alphabet alphabet_t, std::unsigned_integral word_t>
+        void expand_iupac_masks(std::span<word_t> const masks,
+                                std::size_t const block_count,
+                                bool const match_bit,
+                                iupac_matching const config) {
+            constexpr std::size_t alphabet_size = seqan3::alphabet_size<alphabet_t>;
+            assert(masks.size() >= alphabet_size * block_count);
+
+            std::vector<word_t> const needle_masks(masks.begin(), masks.begin() + alphabet_size * block_count);
+            for (std::size_t haystack_rank = 0; haystack_rank < alphabet_size; ++haystack_rank) {
+                for (std::size_t block = 0; block < block_count; ++block) {
+                    word_t mask = (match_bit) ? word_t{0} : static_cast<word_t>(~word_t{0});
+                    for (std::size_t needle_rank = 0; needle_rank < alphabet_size; ++needle_rank) {
+                        if (!iupac_compatible<alphabet_t>(needle_rank, haystack_rank, config))
+                            continue;
+
+                        word_t const needle_mask = needle_masks[needle_rank * block_count + block];
+                        mask = (match_bit) ? (mask | needle_mask) : (mask & needle_mask);
+                    }
+                    masks[haystack_rank * block_count + block] = mask;
+                }
+            }
+        }
+    } // namespace detail
+}  // namespace spm
@@ -0,0 +1,197 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the factory selecting the matcher for a needle based on a calibrated cost model.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+
+#include <libspm/matcher/any_matcher.hpp>
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/horspool_matcher.hpp>
+#include <libspm/matcher/matcher_cost_model.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+#include <libspm/matcher/shiftor_matcher_restorable.hpp>
+
+namespace spm
+{
+    //!\brief The options of spm::make_matcher.
+    struct matcher_options
+    {
+        //!\brief The calibrated cost model or `nullptr` to use the default costs of spm::matcher_cost_model.
+        matcher_cost_model const * cost_model{};
+    };
+
+    namespace detail
+    {
+        /*!\brief Constructs the given engine for the borrowed needle wrapped into `any_matcher_t`.
+         * \throws std::invalid_argument if the engine does not model the concept required by `any_matcher_t` or
+         *         cannot search the needle.
+         */
+        template <typename any_matcher_t, std::ranges::viewable_range needle_t>
+            requires std::ranges::borrowed_range<needle_t>
+        any_matcher_t make_engine(matcher_engine const engine, needle_t && needle, std::size_t const error_count) {
+            auto wrap = [] <typename matcher_t> (matcher_t && matcher) -> any_matcher_t {
+                if constexpr (std::constructible_from<any_matcher_t, matcher_t>)
+                    return any_matcher_t{(matcher_t &&) matcher};
+                else
+                    throw std::invalid_argument{"The engine does not model the concept required by the matcher type."};
+            };
+
+            switch (engine) {
+                case matcher_engine::horspool:
+                    return wrap(horspool_matcher{(needle_t &&) needle});
+                case matcher_engine::shiftor:
+                    return wrap(shiftor_matcher{(needle_t &&) needle});
+                case matcher_engine::restorable_shiftor:
+                    return wrap(restorable_shiftor_matcher{(needle_t &&) needle});
+                case matcher_engine::myers:
+                    return wrap(myers_matcher{(needle_t &&) needle, error_count});
+                case matcher_engine::restorable_myers:
+                    return wrap(restorable_myers_matcher{(needle_t &&) needle, error_count});
+                default:
+                    break;
+            }
+
+            any_matcher_t matcher{};
+            auto assign = [&] (auto & fixed_length_matcher) { matcher = wrap(std::move(fixed_length_matcher)); };
+            bool visited{};
+            if (engine == matcher_engine::fixed_length_shiftor)
+                visited = visit_fixed_length_matcher<fixed_length_shiftor_matcher>(assign, needle);
+            else
+                visited = visit_fixed_length_matcher<fixed_length_myers_matcher>(assign, needle, error_count);
+
+            if (!visited)
+                throw std::invalid_argument{"The needle exceeds the length bound of the fixed-length matchers."};
+            return matcher;
+        }
+
+        inline matcher_engine select_engine(std::size_t const needle_size,
+                                            std::size_t const error_count,
+                                            bool const restorable,
+                                            matcher_options const & options) {
+            matcher_cost_model const default_model{};
+            matcher_cost_model const & model = (options.cost_model != nullptr) ? *options.cost_model : default_model;
+            return model.select(needle_size, error_count, restorable);
+        }
+    } // namespace detail
+
+    /*!\brief Returns the matcher for the needle that is estimated to be the fastest by the cost model.
+     * \tparam haystack_t The view type of the searched haystacks, e.g. `std::span<spm::dna4 const>`.
+     * \param needle The needle, which must not be empty; the returned matcher refers to it. Hence, the needle must be
+     *               an lvalue or a borrowed view, e.g. a std::span, whose underlying sequence outlives the matcher.
+     * \param error_count The maximal number of errors; without errors also the exact matchers are considered.
+     * \param options The options, e.g. the cost model calibrated by spm::calibrate_matcher_cost_model.
+     *
+     * The selected matcher is returned as spm::any_matcher, such that the engine can be chosen at runtime.
+     * The seed-only spm::pigeonhole_matcher is never selected since it reports candidate seeds, not verified hits.
+     */
+    template <std::ranges::view haystack_t, std::ranges::viewable_range needle_t>
+        requires std::ranges::borrowed_range<needle_t>
+    any_matcher<haystack_t> make_matcher(needle_t && needle,
+                                         std::size_t const error_count = 0,
+                                         matcher_options const & options = {}) {
+        matcher_engine const engine = detail::select_engine(std::ranges::size(needle), error_count, false, options);
+        return detail::make_engine<any_matcher<haystack_t>>(engine, (needle_t &&) needle, error_count);
+    }
+
+    //!\brief Returns the fastest matcher for the borrowed needle that models spm::restorable_matcher.
+    template <std::ranges::view haystack_t, std::ranges::viewable_range needle_t>
+        requires std::ranges::borrowed_range<needle_t>
+    any_restorable_matcher<haystack_t> make_restorable_matcher(needle_t && needle,
+                                                               std::size_t const error_count = 0,
+                                                               matcher_options const & options = {}) {
+        matcher_engine const engine = detail::select_engine(std::ranges::size(needle), error_count, true, options);
+        return detail::make_engine<any_restorable_matcher<haystack_t>>(engine, (needle_t &&) needle, error_count);
+    }
+
+    /*!\brief Measures the costs of all engines on this host.
+     * \tparam alphabet_t The alphabet of the needles and haystacks the model is used for.
+     * \param haystack_size The size of the random haystack searched per measurement.
+     *
+     * Every engine searches a random haystack with a short and a long random needle and the costs are fitted to the
+     * measured times. The approximate engines allow an error rate of 10%. The calibration takes a few seconds for the
+     * default haystack size and is supposed to be run once per host; its result should be stored with
+     * spm::matcher_cost_model::write_profile.
+     */
+    template <typename alphabet_t>
+    matcher_cost_model calibrate_matcher_cost_model(std::size_t const haystack_size = 1 << 20) {
+        using rank_t = seqan3::alphabet_rank_t<alphabet_t>;
+        using haystack_t = std::span<alphabet_t const>;
+
+        assert(haystack_size > 0);
+
+        std::mt19937 random_engine{42};
+        auto generate_sequence = [&] (std::size_t const size) {
+            std::vector<alphabet_t> sequence(size);
+            std::ranges::generate(sequence, [&] () {
+                return seqan3::assign_rank_to(static_cast<rank_t>(random_engine() % seqan3::alphabet_size<alphabet_t>),
+                                              alphabet_t{});
+            });
+            return sequence;
+        };
+
+        std::vector<alphabet_t> const haystack = generate_sequence(haystack_size);
+        constexpr std::array<std::size_t, 2> needle_sizes{24, 200};
+        constexpr std::size_t repetitions = 3;
+
+        matcher_cost_model model{};
+        std::size_t hit_count{};
+        for (std::size_t index = 0; index < matcher_engine_count; ++index) {
+            matcher_engine const engine{index};
+            std::array<double, 2> nanoseconds_per_symbol{};
+            for (std::size_t size_index = 0; size_index < needle_sizes.size(); ++size_index) {
+                std::vector<alphabet_t> const needle = generate_sequence(needle_sizes[size_index]);
+                std::size_t const error_count = is_approximate(engine) ? needle.size() / 10 : 0;
+                any_matcher<haystack_t> matcher = detail::make_engine<any_matcher<haystack_t>>(engine,
+                                                                                               needle,
+                                                                                               error_count);
+
+                double best_time = std::numeric_limits<double>::max();
+                for (std::size_t repetition = 0; repetition < repetitions; ++repetition) {
+                    auto const start = std::chrono::steady_clock::now();
+                    hit_count += spm::count(matcher, haystack_t{haystack});
+                    std::chrono::duration<double, std::nano> const time = std::chrono::steady_clock::now() - start;
+                    best_time = std::min(best_time, time.count());
+                }
+                nanoseconds_per_symbol[size_index] = best_time / haystack_size;
+            }
+
+            double const short_load = matcher_engine_load(engine, needle_sizes[0]);
+            double const long_load = matcher_engine_load(engine, needle_sizes[1]);
+            double const load_cost = (nanoseconds_per_symbol[1] - nanoseconds_per_symbol[0]) / (long_load - short_load);
+            model[engine].load_cost = std::max(0.0, load_cost);
+            model[engine].fixed_cost = std::max(0.0, nanoseconds_per_symbol[0] - model[engine].load_cost * short_load);
+        }
+
+        // Keeps the searches from being optimised away.
+        volatile std::size_t const observed_hit_count = hit_count;
+        (void) observed_hit_count;
+        return model;
+    }
+
+}  // namespace spm
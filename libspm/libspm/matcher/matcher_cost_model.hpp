@@ -0,0 +1,231 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the cost model selecting the fastest matcher for a needle.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <libspm/matcher/fixed_length_matcher.hpp>
+
+namespace spm
+{
+    //!\brief The matchers selectable by spm::make_matcher.
+    enum class matcher_engine : std::size_t
+    {
+        horspool, //!< spm::horspool_matcher
+        shiftor, //!< spm::shiftor_matcher
+        restorable_shiftor, //!< spm::restorable_shiftor_matcher
+        fixed_length_shiftor, //!< spm::fixed_length_shiftor_matcher
+        myers, //!< spm::myers_matcher
+        restorable_myers, //!< spm::restorable_myers_matcher
+        fixed_length_myers //!< spm::fixed_length_myers_matcher
+    };
+
+    //!\brief The number of enumerators of spm::matcher_engine.
+    inline constexpr std::size_t matcher_engine_count = 7;
+
+    //!\brief The name of the engine as used in the profile of spm::matcher_cost_model.
+    constexpr std::string_view matcher_engine_name(matcher_engine const engine) noexcept {
+        constexpr std::array<std::string_view, matcher_engine_count> names{"horspool",
+                                                                           "shiftor",
+                                                                           "restorable_shiftor",
+                                                                           "fixed_length_shiftor",
+                                                                           "myers",
+                                                                           "restorable_myers",
+                                                                           "fixed_length_myers"};
+        return names[static_cast<std::size_t>(engine)];
+    }
+
+    //!\brief Whether the engine finds approximate occurrences.
+    constexpr bool is_approximate(matcher_engine const engine) noexcept {
+        return engine == matcher_engine::myers ||
+               engine == matcher_engine::restorable_myers ||
+               engine == matcher_engine::fixed_length_myers;
+    }
+
+    //!\brief Whether the engine models spm::restorable_matcher.
+    constexpr bool is_restorable(matcher_engine const engine) noexcept {
+        return engine == matcher_engine::restorable_shiftor ||
+               engine == matcher_engine::fixed_length_shiftor ||
+               engine == matcher_engine::restorable_myers ||
+               engine == matcher_engine::fixed_length_myers;
+    }
+
+    //!\brief Whether the engine can search the needle of the given size.
+    constexpr bool is_applicable(matcher_engine const engine, std::size_t const needle_size) noexcept {
+        bool const is_fixed_length = engine == matcher_engine::fixed_length_shiftor ||
+                                     engine == matcher_engine::fixed_length_myers;
+        return needle_size > 0 && (!is_fixed_length || needle_size <= fixed_length_buckets.back());
+    }
+
+    /*!\brief The workload of the engine for a needle of the given size.
+     *
+     * The bit-parallel engines process one word per 64 needle symbols, the fixed-length engines the words of the
+     * bucket selected by spm::visit_fixed_length_matcher. Horspool skips up to the needle size per window and thus
+     * its workload decreases with the needle size. The workload of an engine that is not applicable to the needle,
+     * i.e. of a fixed-length engine for a needle exceeding the largest bucket, is infinite.
+     */
+    constexpr double matcher_engine_load(matcher_engine const engine, std::size_t const needle_size) noexcept {
+        assert(needle_size > 0);
+
+        switch (engine) {
+            case matcher_engine::horspool:
+                return 1.0 / static_cast<double>(needle_size);
+            case matcher_engine::fixed_length_shiftor: [[fallthrough]];
+            case matcher_engine::fixed_length_myers: {
+                auto const bucket = std::ranges::find_if(fixed_length_buckets, [&] (std::size_t const bucket_size) {
+                    return needle_size <= bucket_size;
+                });
+                if (bucket == fixed_length_buckets.end())
+                    return std::numeric_limits<double>::infinity();
+                return static_cast<double>(*bucket) / 64.0;
+            }
+            default:
+                return static_cast<double>((needle_size + 63) / 64);
+        }
+    }
+
+    //!\brief The cost of an engine in nanoseconds per haystack symbol, i.e. `fixed_cost + load_cost * load`.
+    struct matcher_cost
+    {
+        double fixed_cost{}; //!< The cost independent of the needle.
+        double load_cost{}; //!< The cost per unit of spm::matcher_engine_load.
+
+    private:
+
+        constexpr friend bool operator==(matcher_cost const &, matcher_cost const &) noexcept = default;
+    };
+
+    /*!\brief Estimates the search time of every spm::matcher_engine and selects the fastest one.
+     *
+     * The default costs are rough estimates. Since the relative speed of the engines depends on the host, the costs
+     * should be calibrated once per host with spm::calibrate_matcher_cost_model and stored as a profile with
+     * spm::matcher_cost_model::write_profile, which is read back with spm::matcher_cost_model::read_profile.
+     * A profile is a text file with one line `<engine name> <fixed cost> <load cost>` per engine; lines starting with
+     * `#` are ignored.
+     */
+    class matcher_cost_model
+    {
+    private:
+
+        std::array<matcher_cost, matcher_engine_count> _costs{{{0.3, 6.0},     // horspool
+                                                               {1.0, 0.8},     // shiftor
+                                                               {1.2, 0.8},     // restorable_shiftor
+                                                               {0.5, 0.5},     // fixed_length_shiftor
+                                                               {1.6, 1.4},     // myers
+                                                               {1.8, 1.4},     // restorable_myers
+                                                               {0.8, 1.0}}};   // fixed_length_myers
+
+    public:
+
+        matcher_cost_model() = default;
+
+        constexpr matcher_cost & operator[](matcher_engine const engine) noexcept {
+            return _costs[static_cast<std::size_t>(engine)];
+        }
+
+        constexpr matcher_cost const & operator[](matcher_engine const engine) const noexcept {
+            return _costs[static_cast<std::size_t>(engine)];
+        }
+
+        //!\brief Returns the estimated nanoseconds per haystack symbol of the engine for a needle of the given size.
+        constexpr double estimate(matcher_engine const engine, std::size_t const needle_size) const noexcept {
+            matcher_cost const & cost = (*this)[engine];
+            return cost.fixed_cost + cost.load_cost * matcher_engine_load(engine, needle_size);
+        }
+
+        /*!\brief Selects the engine with the lowest estimated cost.
+         * \param needle_size The size of the needle; must be greater than zero.
+         * \param error_count The maximal number of errors; exact engines are only considered without errors.
+         * \param restorable Whether only engines modelling spm::restorable_matcher are considered.
+         */
+        constexpr matcher_engine select(std::size_t const needle_size,
+                                        std::size_t const error_count,
+                                        bool const restorable) const noexcept {
+            assert(needle_size > 0);
+
+            matcher_engine best_engine{matcher_engine::restorable_myers}; // applicable to every needle.
+            double best_cost{estimate(best_engine, needle_size)};
+            for (std::size_t index = 0; index < matcher_engine_count; ++index) {
+                matcher_engine const engine{index};
+                if ((error_count > 0 && !is_approximate(engine)) ||
+                    (restorable && !is_restorable(engine)) ||
+                    !is_applicable(engine, needle_size))
+                    continue;
+
+                if (double const cost = estimate(engine, needle_size); cost < best_cost) {
+                    best_engine = engine;
+                    best_cost = cost;
+                }
+            }
+            return best_engine;
+        }
+
+        //!\brief Writes the costs as profile to the given stream.
+        void write_profile(std::ostream & stream) const {
+            std::streamsize const precision = stream.precision(std::numeric_limits<double>::max_digits10);
+            stream << "# libspm matcher cost profile: <engine> <fixed cost> <load cost> in ns per haystack symbol\n";
+            for (std::size_t index = 0; index < matcher_engine_count; ++index)
+                stream << matcher_engine_name(matcher_engine{index}) << ' '
+                       << _costs[index].fixed_cost << ' '
+                       << _costs[index].load_cost << '\n';
+            stream.precision(precision);
+        }
+
+        /*!\brief Reads a profile written by spm::matcher_cost_model::write_profile.
+         * \throws std::runtime_error if the profile contains an unknown engine or a malformed line.
+         *
+         * Engines missing in the profile keep their default costs.
+         */
+        static matcher_cost_model read_profile(std::istream & stream) {
+            matcher_cost_model model{};
+            std::string line{};
+            while (std::getline(stream, line)) {
+                if (line.empty() || line.front() == '#')
+                    continue;
+
+                std::string name{};
+                matcher_cost cost{};
+                std::istringstream fields{line};
+                if (!(fields >> name >> cost.fixed_cost >> cost.load_cost) ||
+                    !std::isfinite(cost.fixed_cost) || !std::isfinite(cost.load_cost))
+                    throw std::runtime_error{"Malformed line in matcher cost profile: " + line};
+
+                std::size_t index = 0;
+                while (index < matcher_engine_count && matcher_engine_name(matcher_engine{index}) != name)
+                    ++index;
+
+                if (index == matcher_engine_count)
+                    throw std::runtime_error{"Unknown engine in matcher cost profile: " + name};
+
+                model._costs[index] = cost;
+            }
+            return model;
+        }
+
+    private:
+
+        friend bool operator==(matcher_cost_model const &, matcher_cost_model const &) noexcept = default;
+    };
+
+}  // namespace spm
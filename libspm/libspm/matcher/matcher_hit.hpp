@@ -0,0 +1,35 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the hit reported by the offset-aware search of a matcher.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace spm
+{
+    /*!\brief A hit in the global coordinates of the haystack.
+     *
+     * For exact matchers the hit spans the occurrence of the needle. For approximate matchers, which only detect the
+     * end of an occurrence, the begin position is the leftmost position an occurrence ending at `end_position` can
+     * start at, i.e. the end position minus the window size of the matcher.
+     */
+    struct matcher_hit
+    {
+        std::size_t begin_position{}; //!< The begin position of the hit.
+        std::size_t end_position{}; //!< The end position of the hit (exclusive).
+
+    private:
+
+        constexpr friend bool operator==(matcher_hit const &, matcher_hit const &) noexcept = default;
+    };
+
+}  // namespace spm
@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a pool of matchers that are rebound to new needles instead of being constructed per needle.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace spm
+{
+    //!\brief A matcher whose needle can be replaced with the given arguments, e.g. the needle and the error count.
+    template <typename matcher_t, typename ...args_t>
+    concept rebindable_matcher = requires (matcher_t & matcher, args_t && ...args)
+    {
+        requires (sizeof...(args_t) == 1 && requires { matcher.set_needle((args_t &&) args...); }) ||
+                 (sizeof...(args_t) > 1 && requires { matcher.rebind((args_t &&) args...); });
+    };
+
+    /*!\brief Hands out matchers that are reused for new needles.
+     * \tparam matcher_t The type of the pooled matchers, e.g. spm::restorable_myers_matcher.
+     *
+     * spm::matcher_pool::acquire returns a lease on a matcher for the given needle. A released matcher is rebound to
+     * the next needle through `set_needle` or `rebind`, which reuses the memory of its preprocessed tables, while
+     * a new matcher is constructed only if all matchers of the pool are leased.
+     * The pool is not synchronised; every thread is supposed to use its own pool, which also keeps the matchers in
+     * memory local to the thread.
+     */
+    template <typename matcher_t>
+    class matcher_pool
+    {
+    private:
+
+        std::deque<matcher_t> _matchers{}; // stable addresses of all matchers.
+        std::vector<matcher_t *> _free_matchers{}; // capacity for all matchers, such that release cannot throw.
+
+    public:
+
+        //!\brief The exclusive access to a pooled matcher, which is returned to the pool on destruction.
+        class lease
+        {
+        private:
+
+            matcher_pool * _pool{};
+            matcher_t * _matcher{};
+
+            friend matcher_pool;
+
+            lease(matcher_pool & pool, matcher_t & matcher) noexcept :
+                _pool{std::addressof(pool)},
+                _matcher{std::addressof(matcher)}
+            {}
+
+        public:
+
+            lease() = default;
+            lease(lease const &) = delete;
+            lease(lease && other) noexcept :
+                _pool{std::exchange(other._pool, nullptr)},
+                _matcher{std::exchange(other._matcher, nullptr)}
+            {}
+
+            lease & operator=(lease const &) = delete;
+            lease & operator=(lease && other) noexcept {
+                release();
+                _pool = std::exchange(other._pool, nullptr);
+                _matcher = std::exchange(other._matcher, nullptr);
+                return *this;
+            }
+
+            ~lease() {
+                release();
+            }
+
+            matcher_t & operator*() const noexcept {
+                assert(_matcher != nullptr);
+                return *_matcher;
+            }
+
+            matcher_t * operator->() const noexcept {
+                assert(_matcher != nullptr);
+                return _matcher;
+            }
+
+            //!\brief Returns the matcher to the pool.
+            void release() noexcept {
+                if (_matcher != nullptr)
+                    _pool->_free_matchers.push_back(std::exchange(_matcher, nullptr));
+            }
+        };
+
+        matcher_pool() = default;
+        matcher_pool(matcher_pool const &) = delete;
+        matcher_pool & operator=(matcher_pool const &) = delete;
+
+        /*!\brief Returns a matcher for the given needle.
+         * \param args The arguments to construct the matcher with, e.g. the needle and the maximal number of errors.
+         *
+         * Reuses a released matcher by passing the arguments to `set_needle` if only the needle is given, or to
+         * `rebind` otherwise. The pool must outlive the returned lease.
+         */
+        template <typename ...args_t>
+            requires std::constructible_from<matcher_t, args_t...> && rebindable_matcher<matcher_t, args_t...>
+        lease acquire(args_t && ...args) {
+            if (_free_matchers.empty()) {
+                _free_matchers.reserve(_matchers.size() + 1);
+                return lease{*this, _matchers.emplace_back((args_t &&) args...)};
+            }
+
+            matcher_t & matcher = *_free_matchers.back();
+            if constexpr (sizeof...(args_t) == 1)
+                matcher.set_needle((args_t &&) args...);
+            else
+                matcher.rebind((args_t &&) args...);
+
+            _free_matchers.pop_back();
+            return lease{*this, matcher};
+        }
+
+        //!\brief The number of matchers constructed by the pool.
+        std::size_t size() const noexcept {
+            return _matchers.size();
+        }
+    };
+
+}  // namespace spm
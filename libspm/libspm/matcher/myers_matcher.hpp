@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <optional>
+
+#include <libspm/matcher/iupac_masks.hpp>
 #include <libspm/matcher/seqan_pattern_base.hpp>
 
 namespace spm
@@ -30,6 +33,7 @@ namespace spm
 
         pattern_type _pattern{};
         int32_t _min_score{};
+        std::optional<iupac_matching> _iupac{};
 
     public:
 
@@ -42,8 +46,52 @@ namespace spm
             _min_score{-static_cast<int32_t>(max_error_count)}
         {}
 
+        //!\brief Constructs the matcher such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<_needle_t, myers_matcher> &&
+                       std::constructible_from<compatible_needle_type, _needle_t>)
+        myers_matcher(_needle_t && needle, std::size_t max_error_count, iupac_matching const config) :
+            myers_matcher{(_needle_t &&) needle, max_error_count}
+        {
+            _iupac = config;
+            expand_iupac_masks();
+        }
+
+        /*!\brief Replaces the needle and the maximal number of errors without constructing a new matcher.
+         *
+         * The preprocessing reuses the masks of the previous needle where possible.
+         * The new needle must be convertible to the needle type of the matcher.
+         */
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void rebind(_needle_t && needle, std::size_t const max_error_count) {
+            set_needle((_needle_t &&) needle);
+            _min_score = -static_cast<int32_t>(max_error_count);
+        }
+
+        //!\brief Replaces the needle and keeps the maximal number of errors.
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            seqan2::setHost(_pattern, spm::make_seqan_container(needle_t{(_needle_t &&) needle}));
+            expand_iupac_masks();
+        }
+
+        //!\brief The number of errors of the last reported hit, i.e. to be called from within the callback.
+        constexpr std::size_t error_count() noexcept {
+            return static_cast<std::size_t>(-seqan2::getScore(_pattern));
+        }
+
     private:
 
+        // Folds the configured IUPAC compatibility into the masks computed for the current needle.
+        constexpr void expand_iupac_masks() {
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<std::ranges::range_value_t<needle_t>>(
+                    std::span{seqan2::begin(_pattern.bitMasks, seqan2::Standard()), seqan2::length(_pattern.bitMasks)},
+                    _pattern.blockCount, true, *_iupac);
+        }
+
         constexpr auto custom_find_arguments() const noexcept {
             return std::tuple{_min_score};
         }
@@ -59,4 +107,7 @@ namespace spm
     template <std::ranges::viewable_range needle_t>
     myers_matcher(needle_t &&, std::size_t) -> myers_matcher<std::views::all_t<needle_t>>;
 
+    template <std::ranges::viewable_range needle_t>
+    myers_matcher(needle_t &&, std::size_t, iupac_matching) -> myers_matcher<std::views::all_t<needle_t>>;
+
 }  // namespace spm
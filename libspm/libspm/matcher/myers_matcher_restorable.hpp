@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <optional>
+
+#include <libspm/matcher/iupac_masks.hpp>
 #include <libspm/matcher/seqan_pattern_base.hpp>
 #include <libspm/matcher/seqan_restorable_pattern.hpp>
+#include <libspm/seqan/serialisation.hpp>
 
 namespace seqan2 {
     template <typename needle_t>
@@ -39,6 +43,16 @@ namespace seqan2 {
             _patternInit(to_base(), to_state(), std::ignore);
         }
 
+        //!\brief Preprocesses a new needle, reusing the allocated masks where possible, and resets the state.
+        template <typename _needle_t, std::unsigned_integral error_count_t>
+        constexpr void rebind(_needle_t && needle, error_count_t const max_error_count) {
+            setHost(to_base(), (_needle_t &&) needle);
+            setScoreLimit(to_base(), -static_cast<int32_t>(max_error_count));
+            _patternFirstInit(to_base(), seqan2::needle(to_base()));
+            _patternInit(to_base(), to_state(), std::ignore);
+            _first_find = true;
+        }
+
         template <typename finder_t>
         constexpr bool operator()(finder_t & finder) noexcept {
             using haystack_t = typename Haystack<finder_t>::Type;
@@ -120,6 +134,7 @@ namespace spm
         using pattern_type = seqan2::Pattern<compatible_needle_type, Restorable<seqan2::Myers<>>>;
 
         pattern_type _pattern{};
+        std::optional<iupac_matching> _iupac{};
 
     public:
 
@@ -133,6 +148,17 @@ namespace spm
             _pattern{spm::make_seqan_container(std::views::all((_needle_t &&) needle)), error_count}
         {}
 
+        //!\brief Constructs the matcher such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t, std::unsigned_integral error_count_t>
+            requires (!std::same_as<_needle_t, restorable_myers_matcher> &&
+                       std::constructible_from<compatible_needle_type, _needle_t>)
+        restorable_myers_matcher(_needle_t && needle, error_count_t const error_count, iupac_matching const config) :
+            restorable_myers_matcher{(_needle_t &&) needle, error_count}
+        {
+            _iupac = config;
+            expand_iupac_masks();
+        }
+
         constexpr state_type const & capture() const noexcept {
             return _pattern.capture();
         }
@@ -141,8 +167,40 @@ namespace spm
             _pattern.restore(std::move(state));
         }
 
+        /*!\brief Replaces the needle and the maximal number of errors without constructing a new matcher.
+         *
+         * The preprocessing reuses the memory of the previous needle where possible and the search state is reset.
+         * The new needle must be convertible to the needle type of the matcher.
+         */
+        template <std::ranges::viewable_range _needle_t, std::unsigned_integral error_count_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void rebind(_needle_t && needle, error_count_t const error_count) {
+            _pattern.rebind(spm::make_seqan_container(needle_t{(_needle_t &&) needle}), error_count);
+            expand_iupac_masks();
+        }
+
+        //!\brief Replaces the needle and keeps the maximal number of errors.
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            rebind((_needle_t &&) needle, static_cast<std::size_t>(-seqan2::scoreLimit(_pattern)));
+        }
+
+        //!\brief The number of errors of the last reported hit, i.e. to be called from within the callback.
+        constexpr std::size_t error_count() noexcept {
+            return static_cast<std::size_t>(-seqan2::getScore(_pattern));
+        }
+
     private:
 
+        // Folds the configured IUPAC compatibility into the masks computed for the current needle.
+        constexpr void expand_iupac_masks() {
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<std::ranges::range_value_t<needle_t>>(
+                    std::span{seqan2::begin(_pattern.bitMasks, seqan2::Standard()), seqan2::length(_pattern.bitMasks)},
+                    _pattern.blockCount, true, *_iupac);
+        }
+
         constexpr pattern_type & get_pattern() noexcept {
             return _pattern;
         }
@@ -155,4 +213,8 @@ namespace spm
     template <std::ranges::viewable_range needle_t, std::unsigned_integral error_count_t>
     restorable_myers_matcher(needle_t &&, error_count_t) -> restorable_myers_matcher<std::views::all_t<needle_t>>;
 
+    template <std::ranges::viewable_range needle_t, std::unsigned_integral error_count_t>
+    restorable_myers_matcher(needle_t &&, error_count_t, iupac_matching)
+        -> restorable_myers_matcher<std::views::all_t<needle_t>>;
+
 }  // namespace spm
@@ -0,0 +1,330 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an inter-sequence vectorised myers matcher searching one needle in several haystacks at once.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/core/concept/cereal.hpp>
+#include <seqan3/utility/simd/simd.hpp>
+
+#if SEQAN3_WITH_CEREAL
+#include <cereal/types/array.hpp>
+#endif
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/iupac_masks.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    //!\brief A hit reported by the spm::simd_myers_matcher.
+    struct multi_haystack_hit
+    {
+        std::size_t haystack_id{}; //!< The index of the haystack (lane) the hit was found in.
+        std::size_t end_position{}; //!< The end position of the hit in the haystack (exclusive).
+        std::size_t error_count{}; //!< The number of errors of the hit.
+
+    private:
+
+        constexpr friend bool operator==(multi_haystack_hit const &, multi_haystack_hit const &) noexcept = default;
+    };
+
+    /*!\brief Searches one needle in up to `lane_count` haystacks simultaneously.
+     *
+     * Implements the bit-parallel algorithm of Myers where every SIMD lane carries the VP/VN state of one haystack
+     * while all lanes share the same needle masks. Hence, the preprocessing of the needle is done only once and the
+     * haystacks, e.g. the haplotypes of a population, are scanned in lockstep.
+     * The needle must fit into a single `word_t` and every haystack is assigned to a fixed lane, i.e. the haystack
+     * at index `i` of the passed range is always processed by lane `i`.
+     * The state of every lane can be captured and restored individually.
+     */
+    template <std::ranges::random_access_range needle_t,
+              std::unsigned_integral word_t = uint32_t,
+              std::size_t lane_count = 8>
+    class simd_myers_matcher
+    {
+    private:
+
+        using alphabet_type = std::ranges::range_value_t<needle_t>;
+        using simd_type = seqan3::simd::simd_type_t<word_t, lane_count>;
+
+        static constexpr std::size_t word_size = std::numeric_limits<word_t>::digits;
+        // The number of positions whose masks are transposed into the lane-interleaved buffer at once.
+        static constexpr std::size_t block_size = 64;
+
+        std::vector<word_t> _needle_masks{}; // one mask per symbol shared by all lanes.
+        word_t _needle_size{};
+        word_t _max_error_count{};
+        std::optional<iupac_matching> _iupac{};
+
+        simd_type _vp{};
+        simd_type _vn{};
+        simd_type _score{};
+
+    public:
+
+        //!\brief The state of a single lane.
+        struct lane_state_type
+        {
+            word_t vp{};
+            word_t vn{};
+            word_t score{};
+
+            template <seqan3::cereal_archive archive_t>
+            void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+                archive(vp, vn, score);
+            }
+
+        private:
+
+            constexpr friend bool operator==(lane_state_type const &, lane_state_type const &) noexcept = default;
+        };
+
+        using state_type = std::array<lane_state_type, lane_count>;
+
+        simd_myers_matcher() = delete;
+        template <std::ranges::viewable_range _needle_t, std::unsigned_integral error_count_t = word_t>
+            requires (!std::same_as<std::remove_cvref_t<_needle_t>, simd_myers_matcher>)
+        explicit simd_myers_matcher(_needle_t && needle, error_count_t const max_error_count = 0u) :
+            _needle_masks(seqan3::alphabet_size<alphabet_type>, 0)
+        {
+            rebind((_needle_t &&) needle, max_error_count);
+        }
+
+        //!\brief Constructs the matcher such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t, std::unsigned_integral error_count_t>
+            requires (!std::same_as<std::remove_cvref_t<_needle_t>, simd_myers_matcher>)
+        simd_myers_matcher(_needle_t && needle, error_count_t const max_error_count, iupac_matching const config) :
+            _needle_masks(seqan3::alphabet_size<alphabet_type>, 0),
+            _iupac{config}
+        {
+            rebind((_needle_t &&) needle, max_error_count);
+        }
+
+        /*!\brief Replaces the needle and the maximal number of errors, reusing the masks, and resets all lanes.
+         * \throws std::invalid_argument if the needle does not fit into a single `word_t`.
+         */
+        template <std::ranges::viewable_range _needle_t, std::unsigned_integral error_count_t>
+        constexpr void rebind(_needle_t && needle, error_count_t const max_error_count) {
+            if (std::ranges::size(needle) > word_size)
+                throw std::invalid_argument{"The needle must fit into a single machine word."};
+
+            _needle_size = static_cast<word_t>(std::ranges::size(needle));
+            _max_error_count = static_cast<word_t>(max_error_count);
+            std::ranges::fill(_needle_masks, word_t{0});
+            word_t bit{1};
+            for (auto && symbol : needle) {
+                _needle_masks[seqan3::to_rank(symbol)] |= bit;
+                bit <<= 1;
+            }
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<alphabet_type>(std::span{_needle_masks}, 1, true, *_iupac);
+            restore(initial_state());
+        }
+
+        //!\brief Replaces the needle and keeps the maximal number of errors.
+        template <std::ranges::viewable_range _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            rebind((_needle_t &&) needle, _max_error_count);
+        }
+
+        /*!\brief Searches the needle in all given haystacks.
+         * \param haystacks A range over at most `lane_count` haystacks.
+         * \param callback The callback invoked with a spm::multi_haystack_hit for every hit.
+         * \returns spm::search_control::stop if the callback stopped the search, otherwise
+         *          spm::search_control::proceed.
+         *
+         * The haystacks may have different lengths. A lane whose haystack is exhausted keeps its state, such that
+         * it can be captured afterwards and continued with the next chunk of the same haystack. If the callback stops
+         * the search at a hit of lane `l` ending at position `p`, the lanes up to `l` cover their haystack up to `p` and
+         * the following lanes up to `p - 1`, i.e. the following lanes have not yet reported their hits ending at `p`.
+         * Hence, the search is resumed without losing or repeating hits by continuing the lanes up to `l` at position
+         * `p` and the following lanes at position `p - 1` of their haystack.
+         */
+        template <std::ranges::forward_range haystacks_t, typename callback_t>
+            requires std::ranges::random_access_range<std::ranges::range_reference_t<haystacks_t>> &&
+                     std::ranges::sized_range<std::ranges::range_reference_t<haystacks_t>>
+        constexpr search_control operator()(haystacks_t && haystacks, callback_t && callback) {
+            using haystack_t = std::remove_reference_t<std::ranges::range_reference_t<haystacks_t>>;
+            using haystack_iterator_t = std::ranges::iterator_t<haystack_t>;
+
+            assert(static_cast<std::size_t>(std::ranges::distance(haystacks)) <= lane_count);
+
+            if (_needle_size == 0)
+                return search_control::proceed;
+
+            std::array<haystack_iterator_t, lane_count> haystack_it{};
+            std::array<std::size_t, lane_count> haystack_size{};
+            std::size_t active_lane_count{};
+            std::size_t max_haystack_size{};
+            for (auto && haystack : haystacks) {
+                haystack_it[active_lane_count] = std::ranges::begin(haystack);
+                haystack_size[active_lane_count] = std::ranges::size(haystack);
+                max_haystack_size = std::max(max_haystack_size, haystack_size[active_lane_count]);
+                ++active_lane_count;
+            }
+
+            // The masks of a block of positions are stored lane-interleaved, such that the recurrence loads the
+            // masks of every position as a whole vector instead of gathering them lane by lane.
+            std::array<simd_type, block_size> block_eq;
+            std::array<simd_type, block_size> block_active;
+            for (std::size_t block_begin = 0; block_begin < max_haystack_size; block_begin += block_size) {
+                std::size_t const block_end = std::min(block_begin + block_size, max_haystack_size);
+                transpose_block(haystack_it, haystack_size, active_lane_count, block_begin, block_end,
+                                block_eq, block_active);
+
+                for (std::size_t position = block_begin; position < block_end; ++position) {
+                    if (step(block_eq[position - block_begin], block_active[position - block_begin], position,
+                             active_lane_count, callback) == search_control::stop)
+                        return search_control::stop;
+                }
+            }
+            return search_control::proceed;
+        }
+
+        constexpr state_type capture() const noexcept {
+            state_type state{};
+            for (std::size_t lane = 0; lane < lane_count; ++lane)
+                state[lane] = capture(lane);
+            return state;
+        }
+
+        constexpr lane_state_type capture(std::size_t const lane) const noexcept {
+            assert(lane < lane_count);
+            return lane_state_type{.vp = _vp[lane], .vn = _vn[lane], .score = _score[lane]};
+        }
+
+        constexpr void restore(state_type const & state) noexcept {
+            for (std::size_t lane = 0; lane < lane_count; ++lane)
+                restore(lane, state[lane]);
+        }
+
+        constexpr void restore(std::size_t const lane, lane_state_type const & state) noexcept {
+            assert(lane < lane_count);
+            _vp[lane] = state.vp;
+            _vn[lane] = state.vn;
+            _score[lane] = state.score;
+        }
+
+        //!\brief Returns the state of a lane that has not seen any symbol yet.
+        constexpr lane_state_type initial_lane_state() const noexcept {
+            return lane_state_type{.vp = ~word_t{0}, .vn = 0, .score = _needle_size};
+        }
+
+        constexpr state_type initial_state() const noexcept {
+            state_type state{};
+            std::ranges::fill(state, initial_lane_state());
+            return state;
+        }
+
+        static constexpr std::size_t lanes() noexcept {
+            return lane_count;
+        }
+
+    private:
+
+        /*!\brief Writes the needle masks of the positions `[block_begin, block_end)` of every haystack to its lane.
+         *
+         * Every haystack is read sequentially. Lanes whose haystack is exhausted or absent get an empty mask and are
+         * marked inactive.
+         */
+        template <typename haystack_iterator_t>
+        constexpr void transpose_block(std::array<haystack_iterator_t, lane_count> const & haystack_it,
+                                       std::array<std::size_t, lane_count> const & haystack_size,
+                                       std::size_t const active_lane_count,
+                                       std::size_t const block_begin,
+                                       std::size_t const block_end,
+                                       std::array<simd_type, block_size> & block_eq,
+                                       std::array<simd_type, block_size> & block_active) const noexcept {
+            std::fill_n(block_eq.begin(), block_end - block_begin, simd_type{});
+            std::fill_n(block_active.begin(), block_end - block_begin, simd_type{});
+            for (std::size_t lane = 0; lane < active_lane_count; ++lane) {
+                std::size_t const lane_end = std::clamp(haystack_size[lane], block_begin, block_end);
+                auto symbol_it = haystack_it[lane] + block_begin;
+                for (std::size_t offset = 0; offset < lane_end - block_begin; ++offset, ++symbol_it) {
+                    block_eq[offset][lane] = _needle_masks[seqan3::to_rank(*symbol_it)];
+                    block_active[offset][lane] = ~word_t{0};
+                }
+            }
+        }
+
+        //!\brief Advances the active lanes by one position and reports their hits.
+        template <typename callback_t>
+        constexpr search_control step(simd_type const & eq,
+                                      simd_type const & is_active,
+                                      std::size_t const position,
+                                      std::size_t const active_lane_count,
+                                      callback_t & callback) {
+            word_t const last_bit_shift = _needle_size - 1;
+            simd_type const xv = eq | _vn;
+            simd_type const xh = (((eq & _vp) + _vp) ^ _vp) | eq;
+            simd_type hp = _vn | ~(xh | _vp);
+            simd_type hn = _vp & xh;
+            simd_type const score = _score + ((hp >> last_bit_shift) & 1) - ((hn >> last_bit_shift) & 1);
+            hp <<= 1;
+            hn <<= 1;
+            simd_type const vp = hn | ~(xv | hp);
+            simd_type const vn = hp & xv;
+
+            // Only lanes whose haystack is not yet exhausted are updated.
+            simd_type const previous_vp = _vp;
+            simd_type const previous_vn = _vn;
+            simd_type const previous_score = _score;
+            _vp = (vp & is_active) | (_vp & ~is_active);
+            _vn = (vn & is_active) | (_vn & ~is_active);
+            _score = (score & is_active) | (_score & ~is_active);
+
+            for (std::size_t lane = 0; lane < active_lane_count; ++lane) {
+                if (is_active[lane] && _score[lane] <= _max_error_count &&
+                    detail::invoke_hit_callback(callback, multi_haystack_hit{.haystack_id = lane,
+                                                                             .end_position = position + 1,
+                                                                             .error_count = _score[lane]})
+                        == search_control::stop) {
+                    // The following lanes are reset to the previous position to report their hits on resumption.
+                    for (std::size_t next_lane = lane + 1; next_lane < active_lane_count; ++next_lane) {
+                        _vp[next_lane] = previous_vp[next_lane];
+                        _vn[next_lane] = previous_vn[next_lane];
+                        _score[next_lane] = previous_score[next_lane];
+                    }
+                    return search_control::stop;
+                }
+            }
+            return search_control::proceed;
+        }
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>, simd_myers_matcher const & me) noexcept {
+            return (me._needle_size == 0) ? 0 : me._needle_size + me._max_error_count;
+        }
+    };
+
+    template <std::ranges::viewable_range needle_t>
+    simd_myers_matcher(needle_t &&) -> simd_myers_matcher<std::views::all_t<needle_t>>;
+
+    template <std::ranges::viewable_range needle_t, std::unsigned_integral error_count_t>
+    simd_myers_matcher(needle_t &&, error_count_t) -> simd_myers_matcher<std::views::all_t<needle_t>>;
+
+    template <std::ranges::viewable_range needle_t, std::unsigned_integral error_count_t>
+    simd_myers_matcher(needle_t &&, error_count_t, iupac_matching) -> simd_myers_matcher<std::views::all_t<needle_t>>;
+
+}  // namespace spm
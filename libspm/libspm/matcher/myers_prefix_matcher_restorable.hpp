@@ -14,6 +14,7 @@
 
 #include <libspm/matcher/seqan_pattern_base.hpp>
 #include <libspm/matcher/seqan_restorable_pattern.hpp>
+#include <libspm/seqan/serialisation.hpp>
 
 namespace seqan2 {
 
@@ -44,6 +45,18 @@ namespace seqan2 {
             }
         }
 
+        //!\brief Preprocesses a new needle, reusing the allocated masks where possible, and resets the state.
+        template <typename _needle_t, std::unsigned_integral error_count_t>
+        constexpr void rebind(_needle_t && needle, error_count_t const max_error_count) {
+            setHost(to_base(), (_needle_t &&) needle);
+            setScoreLimit(to_base(), -static_cast<int32_t>(max_error_count));
+            if (!empty(to_base().data_host)) {
+                _patternFirstInit(to_base(), seqan2::needle(to_base()));
+                _patternInit(to_base(), to_state(), std::ignore);
+            }
+            _first_find = true;
+        }
+
         template <typename finder_t>
         constexpr bool operator()(finder_t & finder) noexcept {
             using haystack_t = typename Haystack<finder_t>::Type;
@@ -148,6 +161,20 @@ namespace spm
             _pattern.restore(std::move(state));
         }
 
+        //!\brief Replaces the needle and the maximal number of errors without constructing a new matcher.
+        template <std::ranges::viewable_range _needle_t, std::unsigned_integral error_count_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void rebind(_needle_t && needle, error_count_t const error_count) {
+            _pattern.rebind(spm::make_seqan_container(needle_t{(_needle_t &&) needle}), error_count);
+        }
+
+        //!\brief Replaces the needle and keeps the maximal number of errors.
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            rebind((_needle_t &&) needle, static_cast<std::size_t>(-seqan2::scoreLimit(_pattern.capture())));
+        }
+
     private:
 
         constexpr pattern_type & get_pattern() noexcept {
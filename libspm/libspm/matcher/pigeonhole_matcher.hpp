@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <libspm/seqan/container_adapter.hpp>
 
 #include <seqan/index.h>
@@ -142,9 +144,8 @@ namespace spm
         using index_type = seqan2::Index<multi_needle_type, seqan2::IndexQGram<qgram_shape_type, seqan2::OpenAddressing>>;
         using pattern_type = seqan2::Pattern<index_type, finder_spec_type>;
 
-        multi_needle_type _multi_needle{};
-        index_type _needle_index{_multi_needle};
-        pattern_type _pattern{_needle_index};
+        std::shared_ptr<index_type const> _needle_index{}; // shared by all copies of the matcher.
+        pattern_type _pattern{};
         double _error_rate{};
 
     public:
@@ -154,31 +155,48 @@ namespace spm
             requires (!std::same_as<_needle_t, pigeonhole_matcher> &&
                        std::constructible_from<compatible_needle_type, _needle_t>)
         explicit pigeonhole_matcher(_needle_t && needle, double error_rate = 0.0) :
-            _error_rate{error_rate}
-        {
-            appendValue(getFibre(_needle_index, seqan2::QGramText{}),
-                        spm::make_seqan_container(std::views::all((_needle_t &&) needle)));
-            _patternInit(_pattern, _error_rate);
-        }
+            pigeonhole_matcher{index_needle((_needle_t &&) needle), error_rate}
+        {}
 
         template <std::ranges::viewable_range _multi_needle_t>
             requires (!std::same_as<_multi_needle_t, pigeonhole_matcher> &&
                        std::constructible_from<compatible_needle_type,
                                                std::ranges::range_reference_t<_multi_needle_t>>)
         explicit pigeonhole_matcher(_multi_needle_t && multi_needle, double error_rate = 0.0) :
+            pigeonhole_matcher{index_multi_needle((_multi_needle_t &&) multi_needle), error_rate}
+        {}
+
+        constexpr auto position() const noexcept {
+            return seqan2::position(_pattern);
+        }
+    private:
+
+        // The q-gram index is completed by seqan2::_patternInit and only read by the search. Hence, it is built once and
+        // the patterns of all copies of the matcher refer to the same index.
+        pigeonhole_matcher(std::shared_ptr<index_type> needle_index, double const error_rate) :
+            _pattern{*needle_index},
             _error_rate{error_rate}
         {
-            for (auto && needle : multi_needle)
-                appendValue(getFibre(_needle_index, seqan2::QGramText{}),
-                            spm::make_seqan_container(std::views::all((decltype(needle) &&) needle)));
-
             _patternInit(_pattern, _error_rate);
+            _needle_index = std::move(needle_index);
         }
 
-        constexpr auto position() const noexcept {
-            return seqan2::position(_pattern);
+        template <typename _needle_t>
+        static std::shared_ptr<index_type> index_needle(_needle_t && needle) {
+            auto needle_index = std::make_shared<index_type>();
+            appendValue(getFibre(*needle_index, seqan2::QGramText{}),
+                        spm::make_seqan_container(std::views::all((_needle_t &&) needle)));
+            return needle_index;
+        }
+
+        template <typename _multi_needle_t>
+        static std::shared_ptr<index_type> index_multi_needle(_multi_needle_t && multi_needle) {
+            auto needle_index = std::make_shared<index_type>();
+            for (auto && needle : multi_needle)
+                appendValue(getFibre(*needle_index, seqan2::QGramText{}),
+                            spm::make_seqan_container(std::views::all((decltype(needle) &&) needle)));
+            return needle_index;
         }
-    private:
 
         template <typename haystack_t>
         constexpr auto make_finder(haystack_t & haystack) const noexcept
@@ -190,6 +208,16 @@ namespace spm
                 return seqan2::Finder<haystack_t, finder_spec_type>{haystack};
         }
 
+        // The seeds are reported by their begin position.
+        template <typename seqan_finder_t>
+        static constexpr matcher_hit make_hit(seqan_finder_t const & finder,
+                                              std::size_t const base_offset,
+                                              std::size_t const window) noexcept
+        {
+            std::size_t const begin = base_offset + seqan2::beginPosition(finder);
+            return matcher_hit{.begin_position = begin, .end_position = begin + window};
+        }
+
         constexpr pigeonhole_matcher & get_pattern() noexcept {
             return *this;
         }
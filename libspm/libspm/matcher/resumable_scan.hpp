@@ -0,0 +1,188 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the search of a long haystack that persists its progress and resumes after a restart.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <cereal/archives/binary.hpp>
+
+#include <seqan3/core/concept/cereal.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    //!\brief The default number of haystack symbols searched by spm::resumable_scan between two checkpoints.
+    inline constexpr std::size_t default_resumable_scan_interval = std::size_t{1} << 26;
+
+    //!\brief The progress of a spm::resumable_scan as stored in its checkpoint file.
+    template <typename state_t>
+    struct scan_checkpoint
+    {
+        std::size_t offset{}; //!< The number of haystack symbols searched so far.
+        std::size_t hit_count{}; //!< The hit cursor, i.e. the number of hits reported before `offset`.
+        state_t state{}; //!< The state of the matcher at `offset`.
+
+        template <seqan3::cereal_archive archive_t>
+        void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+            archive(offset, hit_count, state);
+        }
+    };
+
+    /*!\brief Searches a haystack in intervals and writes a checkpoint file after every interval.
+     * \tparam matcher_t The type of the matcher; must model spm::restorable_matcher with a serialisable state.
+     *
+     * After every `checkpoint_interval` symbols the offset, the state of the matcher and the hit cursor are written
+     * to the checkpoint file. The file is replaced atomically, such that a process killed while writing leaves the
+     * previous checkpoint intact. A scan constructed with an existing checkpoint file restores its progress from it
+     * and the next search continues at the stored offset of the same haystack. The hits between the last checkpoint
+     * and the termination of the previous process are reported again; a consumer storing the hits can truncate its
+     * output to spm::resumable_scan::hit_count before the search to avoid duplicates.
+     *
+     * The checkpoint is written with a cereal binary archive and is therefore only portable between hosts of the
+     * same endianness.
+     */
+    template <typename matcher_t>
+        requires restorable_matcher<matcher_t &> && seqan3::cerealisable<matcher_state_t<matcher_t &>>
+    class resumable_scan
+    {
+    private:
+
+        using checkpoint_type = scan_checkpoint<matcher_state_t<matcher_t &>>;
+
+        matcher_t _matcher;
+        std::filesystem::path _checkpoint_path{};
+        std::size_t _checkpoint_interval{};
+        checkpoint_type _checkpoint{};
+
+    public:
+
+        resumable_scan() = delete;
+        /*!\brief Constructs the scan and restores the progress from the checkpoint file if it exists.
+         * \param matcher The matcher, whose current state is the state before the haystack; after a restart it must be
+         *                constructed as in the process that wrote the checkpoint file.
+         * \param checkpoint_path The path of the checkpoint file.
+         * \param checkpoint_interval The number of haystack symbols between two checkpoints; must be greater than 0.
+         * \throws std::runtime_error if the existing checkpoint file cannot be read.
+         */
+        resumable_scan(matcher_t matcher,
+                       std::filesystem::path checkpoint_path,
+                       std::size_t const checkpoint_interval = default_resumable_scan_interval) :
+            _matcher{std::move(matcher)},
+            _checkpoint_path{std::move(checkpoint_path)},
+            _checkpoint_interval{checkpoint_interval}
+        {
+            assert(_checkpoint_interval > 0);
+
+            _checkpoint.state = spm::capture(_matcher);
+            if (std::filesystem::exists(_checkpoint_path)) {
+                read_checkpoint();
+                spm::restore(_matcher, _checkpoint.state);
+            }
+        }
+
+        /*!\brief Searches the haystack from the last checkpoint on.
+         * \param haystack The haystack; must be the haystack of the scan that wrote the checkpoint file.
+         * \param callback The callback invoked with the spm::matcher_hit of every hit.
+         * \throws std::runtime_error if the checkpoint file cannot be written.
+         * \returns spm::search_control::stop if the callback stopped the search, otherwise
+         *          spm::search_control::proceed.
+         *
+         * If the callback stops the search, the scan is reset to the last checkpoint.
+         */
+        template <std::ranges::random_access_range haystack_t, typename callback_t>
+            requires std::ranges::sized_range<haystack_t>
+        search_control operator()(haystack_t const & haystack, callback_t && callback) {
+            std::size_t const haystack_size = std::ranges::size(haystack);
+            assert(_checkpoint.offset <= haystack_size);
+
+            while (_checkpoint.offset < haystack_size) {
+                std::size_t const begin = _checkpoint.offset;
+                std::size_t const end = std::min(begin + _checkpoint_interval, haystack_size);
+
+                std::size_t hit_count{};
+                search_control control{search_control::proceed};
+                auto const haystack_begin = std::ranges::begin(haystack);
+                _matcher(std::ranges::subrange{haystack_begin + begin, haystack_begin + end}, begin,
+                         [&] (auto const & hit) {
+                    ++hit_count;
+                    control = detail::invoke_hit_callback(callback, matcher_hit{.begin_position = hit.begin_position,
+                                                                                .end_position = hit.end_position});
+                    return control;
+                });
+
+                if (control == search_control::stop) {
+                    spm::restore(_matcher, _checkpoint.state);
+                    return search_control::stop;
+                }
+
+                _checkpoint.offset = end;
+                _checkpoint.hit_count += hit_count;
+                _checkpoint.state = spm::capture(_matcher);
+                write_checkpoint();
+            }
+            return search_control::proceed;
+        }
+
+        //!\brief The number of haystack symbols searched up to the last checkpoint.
+        constexpr std::size_t offset() const noexcept {
+            return _checkpoint.offset;
+        }
+
+        //!\brief The number of hits reported up to the last checkpoint.
+        constexpr std::size_t hit_count() const noexcept {
+            return _checkpoint.hit_count;
+        }
+
+    private:
+
+        void read_checkpoint() {
+            std::ifstream stream{_checkpoint_path, std::ios::binary};
+            if (!stream)
+                throw std::runtime_error{"Cannot open the checkpoint file: " + _checkpoint_path.string()};
+
+            try {
+                cereal::BinaryInputArchive archive{stream};
+                archive(_checkpoint);
+            } catch (cereal::Exception const &) {
+                throw std::runtime_error{"Malformed checkpoint file: " + _checkpoint_path.string()};
+            }
+        }
+
+        // Writes a temporary file first and renames it, which replaces the previous checkpoint atomically.
+        void write_checkpoint() const {
+            std::filesystem::path temporary_path{_checkpoint_path};
+            temporary_path += ".tmp";
+            {
+                std::ofstream stream{temporary_path, std::ios::binary | std::ios::trunc};
+                cereal::BinaryOutputArchive archive{stream};
+                archive(_checkpoint);
+                stream.flush();
+                if (!stream)
+                    throw std::runtime_error{"Cannot write the checkpoint file: " + temporary_path.string()};
+            }
+            std::filesystem::rename(temporary_path, _checkpoint_path);
+        }
+    };
+
+}  // namespace spm
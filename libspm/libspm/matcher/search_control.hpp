@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the signal to stop a search from within the hit callback as well as hit budgets.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+namespace spm
+{
+    /*!\brief The signal returned by a hit callback to continue or to stop the search.
+     *
+     * Callbacks returning `void` always continue the search. If a callback returns spm::search_control::stop, the
+     * matcher returns immediately after the current hit. The state of a restorable matcher then covers the haystack up
+     * to the end of this hit, such that the search can be resumed with the remaining haystack.
+     */
+    enum class search_control : bool
+    {
+        proceed, //!< Continue the search.
+        stop //!< Stop the search after the current hit.
+    };
+
+    namespace detail
+    {
+        //!\brief Invokes the callback and translates its result into a spm::search_control.
+        template <typename callback_t, typename ...args_t>
+        constexpr search_control invoke_hit_callback(callback_t && callback, args_t && ...args) {
+            if constexpr (std::same_as<std::invoke_result_t<callback_t, args_t...>, search_control>) {
+                return ((callback_t &&) callback)((args_t &&) args...);
+            } else {
+                ((callback_t &&) callback)((args_t &&) args...);
+                return search_control::proceed;
+            }
+        }
+    } // namespace detail
+
+    /*!\brief Wraps a callback such that the search stops after `max_hits` hits.
+     *
+     * The budget is consumed by the hits reported to the wrapped callback; the wrapped callback may still stop the
+     * search earlier. Since every hit passed to the budget is reported, an exhausted budget must not be used for
+     * another search.
+     */
+    template <typename callback_t>
+    class hit_budget
+    {
+    private:
+
+        callback_t _callback;
+        std::size_t _remaining_hits{};
+
+    public:
+
+        hit_budget() = delete;
+        /*!\brief Constructs the budget for the given number of hits.
+         * \throws std::invalid_argument if `max_hits` is 0, since the first hit could neither be reported nor found
+         *         again by a resumed search.
+         */
+        constexpr hit_budget(std::size_t const max_hits, callback_t callback) :
+            _callback{std::move(callback)},
+            _remaining_hits{max_hits}
+        {
+            if (_remaining_hits == 0)
+                throw std::invalid_argument{"The hit budget must allow at least one hit."};
+        }
+
+        template <typename hit_t>
+        constexpr search_control operator()(hit_t && hit) {
+            assert(_remaining_hits > 0);
+
+            --_remaining_hits;
+            search_control const control = detail::invoke_hit_callback(_callback, (hit_t &&) hit);
+            return (_remaining_hits == 0) ? search_control::stop : control;
+        }
+
+        //!\brief The number of hits that can still be reported.
+        constexpr std::size_t remaining_hits() const noexcept {
+            return _remaining_hits;
+        }
+
+        //!\brief Whether the budget is used up.
+        constexpr bool exhausted() const noexcept {
+            return _remaining_hits == 0;
+        }
+    };
+
+    /*!\brief Wraps a callback such that the search stops as soon as a stop is requested for the given token.
+     *
+     * The stop takes effect after the next reported hit, such that no hit found by the matcher is dropped.
+     */
+    template <typename callback_t>
+    constexpr auto stop_when_requested(std::stop_token token, callback_t && callback) {
+        return [token = std::move(token), callback = (callback_t &&) callback] (auto && hit) mutable {
+            search_control const control = detail::invoke_hit_callback(callback, (decltype(hit) &&) hit);
+            return (token.stop_requested()) ? search_control::stop : control;
+        };
+    }
+
+}  // namespace spm
@@ -12,7 +12,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <iterator>
+#include <memory>
 #include <ranges>
 #include <tuple>
 
@@ -22,6 +25,8 @@
 #include <libspm/seqan/container_adapter.hpp>
 
 #include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
 
 namespace spm
 {
@@ -36,26 +41,126 @@ namespace spm
 
     public:
 
+        template <typename haystack_t>
+        class hit_range;
+
+        /*!\brief Searches the haystack and invokes the callback with the seqan2::Finder of every hit.
+         * \returns spm::search_control::stop if the callback stopped the search, otherwise
+         *          spm::search_control::proceed.
+         *
+         * The callback may return a spm::search_control to stop the search after the current hit.
+         */
         // Note const is disabled since seqan use non-const pattern ;(
         template <std::ranges::viewable_range haystack_t, typename callback_t>
-        constexpr void operator()(haystack_t && haystack, callback_t && callback) /*const*/ noexcept {
+            requires (!segmented_haystack<haystack_t>)
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) /*const*/ {
+            search_control control{search_control::proceed};
+            with_finder((haystack_t &&) haystack, [&] (auto & finder) {
+                while (control == search_control::proceed && find_impl(finder, to_derived(this)->get_pattern())) {
+                    control = detail::invoke_hit_callback(callback, finder);
+                }
+            });
+            return control;
+        }
+
+        /*!\brief Searches a part of a larger haystack and reports the hits in the coordinates of the larger haystack.
+         * \param haystack The searched part, e.g. a std::span or std::ranges::subrange; it is not copied.
+         * \param base_offset The position of the first symbol of the searched part within the larger haystack.
+         * \param callback The callback invoked with a spm::matcher_hit for every hit.
+         */
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            std::size_t const window = spm::window_size(*to_derived(this));
+            return (*this)((haystack_t &&) haystack, [&] (auto const & finder) {
+                return detail::invoke_hit_callback(callback, to_derived(this)->make_hit(finder, base_offset, window));
+            });
+        }
+
+        /*!\brief Searches a haystack made of several segments without concatenating them.
+         * \param segments The range over the segments of the haystack.
+         * \param callback The callback invoked with a spm::matcher_hit in the coordinates of the concatenated segments.
+         *
+         * Every segment is searched separately while the state of the restorable matcher is carried over to the next
+         * segment. Hence, hits spanning the boundary of two segments are found as well.
+         */
+        template <segmented_haystack segments_t, typename callback_t, typename _derived_t = derived_t>
+            requires restorable_matcher<_derived_t &>
+        constexpr search_control operator()(segments_t && segments, callback_t && callback) {
+            std::size_t offset{};
+            for (auto && segment : segments) {
+                std::size_t const segment_size = std::ranges::size(segment);
+                if (segment_size > 0 &&
+                    (*this)(std::views::all((decltype(segment) &&) segment), offset, callback) == search_control::stop)
+                    return search_control::stop;
+                offset += segment_size;
+            }
+            return search_control::proceed;
+        }
+
+        constexpr bool empty() const noexcept {
+            return seqan2::empty(get_pattern().data_host);
+        }
+
+    private:
+
+        template <typename haystack_t, typename finder_callback_t>
+        constexpr void with_finder(haystack_t && haystack, finder_callback_t && finder_callback) {
             using compatible_haystack_t = spm::seqan_container_t<std::views::all_t<haystack_t>>;
 
             compatible_haystack_t seqan_haystack =
                 spm::make_seqan_container(std::views::all((haystack_t &&)haystack));
 
             auto finder = to_derived(this)->make_finder(seqan_haystack);
+            finder_callback(finder);
+        }
 
-            while (find_impl(finder, to_derived(this)->get_pattern())) {
-                callback(finder);
-            }
+        // Counts the hits without invoking a callback; derived matchers can provide a specialised kernel.
+        template <typename haystack_t>
+        constexpr std::size_t count_impl(haystack_t && haystack) noexcept {
+            std::size_t hit_count{};
+            with_finder((haystack_t &&) haystack, [&] (auto & finder) {
+                while (find_impl(finder, to_derived(this)->get_pattern()))
+                    ++hit_count;
+            });
+            return hit_count;
         }
 
-        constexpr bool empty() const noexcept {
-            return seqan2::empty(get_pattern().data_host);
+        // Stops at the first hit; derived matchers can provide a specialised kernel.
+        template <typename haystack_t>
+        constexpr bool contains_impl(haystack_t && haystack) noexcept {
+            bool found{false};
+            with_finder((haystack_t &&) haystack, [&] (auto & finder) {
+                found = find_impl(finder, to_derived(this)->get_pattern());
+            });
+            return found;
         }
 
-    private:
+        template <typename haystack_t>
+        constexpr std::size_t dispatch_count(haystack_t && haystack) noexcept {
+            return to_derived(this)->count_impl((haystack_t &&) haystack);
+        }
+
+        template <typename haystack_t>
+        constexpr bool dispatch_contains(haystack_t && haystack) noexcept {
+            return to_derived(this)->contains_impl((haystack_t &&) haystack);
+        }
+
+        // Resumes the search of the finder and stores the next hit; used by the pull-based hit_range.
+        template <typename seqan_finder_t>
+        constexpr bool next_hit(seqan_finder_t & finder, std::size_t const window, matcher_hit & hit) noexcept {
+            if (!find_impl(finder, to_derived(this)->get_pattern()))
+                return false;
+
+            hit = to_derived(this)->make_hit(finder, 0, window);
+            return true;
+        }
+
+        template <typename haystack_t>
+        constexpr auto finder_for(haystack_t & haystack) const noexcept {
+            return to_derived(this)->make_finder(haystack);
+        }
 
         template <typename seqan_finder_t, typename seqan_pattern_t>
         constexpr bool find_impl(seqan_finder_t & finder, seqan_pattern_t && pattern) const noexcept {
@@ -70,6 +175,15 @@ namespace spm
             return seqan2::Finder<haystack_t>{haystack};
         }
 
+        template <typename seqan_finder_t>
+        static constexpr matcher_hit make_hit(seqan_finder_t const & finder,
+                                              std::size_t const base_offset,
+                                              std::size_t const window) noexcept
+        {
+            std::size_t const end = base_offset + seqan2::endPosition(finder);
+            return matcher_hit{.begin_position = end - std::min(end, window), .end_position = end};
+        }
+
         constexpr auto & get_pattern() noexcept
         {
             return to_derived(this)->_pattern;
@@ -97,6 +211,129 @@ namespace spm
         constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>, seqan_pattern_base const & me) noexcept {
             return (me.empty()) ? 0 : seqan2::length(seqan2::needle(me.get_pattern()));
         }
+
+        template <std::ranges::viewable_range haystack_t>
+            requires (!segmented_haystack<haystack_t>)
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::count>, derived_t & me, haystack_t && haystack) noexcept {
+            return static_cast<seqan_pattern_base &>(me).dispatch_count((haystack_t &&) haystack);
+        }
+
+        template <std::ranges::viewable_range haystack_t>
+            requires (!segmented_haystack<haystack_t>)
+        constexpr friend bool tag_invoke(std::tag_t<spm::contains>, derived_t & me, haystack_t && haystack) noexcept {
+            return static_cast<seqan_pattern_base &>(me).dispatch_contains((haystack_t &&) haystack);
+        }
+
+        template <std::ranges::viewable_range haystack_t>
+            requires (!segmented_haystack<haystack_t>)
+        friend hit_range<std::views::all_t<haystack_t>> tag_invoke(std::tag_t<spm::search>,
+                                                                   derived_t & me,
+                                                                   haystack_t && haystack) {
+            return hit_range<std::views::all_t<haystack_t>>{me, std::views::all((haystack_t &&) haystack)};
+        }
+    };
+
+    /*!\brief The lazy input range over the hits returned by spm::search.
+     *
+     * Every increment resumes the seqan2 find loop until the next hit and stores it as spm::matcher_hit in the range.
+     * The haystack and the finder are allocated once when the range is created, such that no allocation happens per
+     * hit. The range is move-only and can be iterated once.
+     * The range is written by hand instead of as a std::generator, since the standard library of GCC 12 does not
+     * provide the `<generator>` header although the tree builds as C++23.
+     */
+    template <typename derived_t>
+    template <typename haystack_t>
+    class seqan_pattern_base<derived_t>::hit_range
+    {
+    private:
+
+        using compatible_haystack_t = spm::seqan_container_t<haystack_t>;
+
+        // Keeps the finder and the haystack it refers to at a stable address.
+        struct search_state
+        {
+            compatible_haystack_t haystack;
+            decltype(std::declval<seqan_pattern_base const &>().finder_for(std::declval<compatible_haystack_t &>())) finder;
+
+            search_state(seqan_pattern_base const & matcher, haystack_t haystack_view) :
+                haystack{spm::make_seqan_container(std::move(haystack_view))},
+                finder{matcher.finder_for(haystack)}
+            {}
+        };
+
+        seqan_pattern_base * _matcher{};
+        std::unique_ptr<search_state> _state{};
+        matcher_hit _hit{};
+        std::size_t _window{};
+        bool _at_end{true};
+
+    public:
+
+        class iterator;
+
+        hit_range() = default;
+        hit_range(derived_t & matcher, haystack_t haystack) :
+            _matcher{std::addressof(static_cast<seqan_pattern_base &>(matcher))},
+            _state{std::make_unique<search_state>(static_cast<seqan_pattern_base const &>(matcher),
+                                                  std::move(haystack))},
+            _window{spm::window_size(matcher)}
+        {}
+
+        hit_range(hit_range &&) = default;
+        hit_range & operator=(hit_range &&) = default;
+
+        iterator begin() {
+            advance();
+            return iterator{this};
+        }
+
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+    private:
+
+        // A default constructed or moved-from range holds no search state and is empty.
+        void advance() {
+            _at_end = _state == nullptr || !_matcher->next_hit(_state->finder, _window, _hit);
+        }
+    };
+
+    template <typename derived_t>
+    template <typename haystack_t>
+    class seqan_pattern_base<derived_t>::hit_range<haystack_t>::iterator
+    {
+    private:
+
+        hit_range * _host{};
+
+    public:
+
+        using value_type = matcher_hit;
+        using reference = matcher_hit const &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+        explicit iterator(hit_range * host) noexcept : _host{host}
+        {}
+
+        reference operator*() const noexcept {
+            return _host->_hit;
+        }
+
+        iterator & operator++() {
+            _host->advance();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++(*this);
+        }
+
+        bool operator==(std::default_sentinel_t const &) const noexcept {
+            return _host->_at_end;
+        }
     };
 
 }  // namespace spm
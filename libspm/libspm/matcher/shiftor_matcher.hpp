@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <optional>
+
+#include <libspm/matcher/iupac_masks.hpp>
 #include <libspm/matcher/seqan_pattern_base.hpp>
 
 namespace spm
@@ -22,12 +25,15 @@ namespace spm
     {
     private:
 
-        friend seqan_pattern_base<shiftor_matcher<needle_t>>;
+        using base_t = seqan_pattern_base<shiftor_matcher<needle_t>>;
+
+        friend base_t;
 
         using compatible_needle_type = spm::seqan_container_t<needle_t>;
         using pattern_type = seqan2::Pattern<compatible_needle_type, seqan2::ShiftOr>;
 
         pattern_type _pattern{};
+        std::optional<iupac_matching> _iupac{};
 
     public:
 
@@ -38,9 +44,90 @@ namespace spm
         explicit shiftor_matcher(_needle_t && needle) :
             _pattern{spm::make_seqan_container(std::views::all((_needle_t &&) needle))}
         {}
+
+        //!\brief Constructs the matcher such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<_needle_t, shiftor_matcher> &&
+                       std::constructible_from<compatible_needle_type, _needle_t>)
+        shiftor_matcher(_needle_t && needle, iupac_matching const config) : shiftor_matcher{(_needle_t &&) needle}
+        {
+            _iupac = config;
+            expand_iupac_masks();
+        }
+
+        /*!\brief Replaces the needle without constructing a new matcher.
+         *
+         * The preprocessing reuses the table of the previous needle where possible.
+         * The new needle must be convertible to the needle type of the matcher.
+         */
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            seqan2::setHost(_pattern, spm::make_seqan_container(needle_t{(_needle_t &&) needle}));
+            expand_iupac_masks();
+        }
+
+    private:
+
+        // Folds the configured IUPAC compatibility into the table computed for the current needle.
+        constexpr void expand_iupac_masks() {
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<std::ranges::range_value_t<needle_t>>(
+                    std::span{seqan2::begin(_pattern.table, seqan2::Standard()), seqan2::length(_pattern.table)},
+                    _pattern.blockCount, false, *_iupac);
+        }
+
+        template <typename haystack_t>
+        constexpr std::size_t count_impl(haystack_t && haystack) noexcept {
+            if (!is_single_word())
+                return base_t::count_impl((haystack_t &&) haystack);
+
+            return scan<false>(haystack);
+        }
+
+        template <typename haystack_t>
+        constexpr bool contains_impl(haystack_t && haystack) noexcept {
+            if (!is_single_word())
+                return base_t::contains_impl((haystack_t &&) haystack);
+
+            return scan<true>(haystack) > 0;
+        }
+
+        constexpr bool is_single_word() const noexcept {
+            return _pattern.blockCount == 1 && _pattern.needleLength > 0;
+        }
+
+        // Runs the shift-or recurrence over the haystack without a finder, accumulating the match bit of the last
+        // needle position. Only applicable to needles fitting into a single word. As in seqan2::ShiftOr, the haystack
+        // symbols are converted to the needle alphabet before the table lookup.
+        template <bool stop_at_first_hit, typename haystack_t>
+        constexpr std::size_t scan(haystack_t && haystack) const noexcept {
+            using word_t = std::remove_cvref_t<decltype(_pattern.table[0])>;
+            using needle_value_t = typename seqan2::Value<compatible_needle_type>::Type;
+
+            word_t const * table = seqan2::begin(_pattern.table, seqan2::Standard());
+            unsigned const last_bit_shift = _pattern.needleLength - 1;
+            word_t state = static_cast<word_t>(~word_t{0});
+            std::size_t hit_count{};
+            for (auto && symbol : haystack) {
+                word_t const mask = table[seqan2::ordValue(seqan2::convert<needle_value_t>(symbol))];
+                state = static_cast<word_t>(state << 1) | mask;
+                std::size_t const is_hit = ((state >> last_bit_shift) & 1) ^ 1;
+                if constexpr (stop_at_first_hit) {
+                    if (is_hit)
+                        return 1;
+                } else {
+                    hit_count += is_hit;
+                }
+            }
+            return hit_count;
+        }
     };
 
     template <std::ranges::viewable_range needle_t>
     shiftor_matcher(needle_t &&) -> shiftor_matcher<std::views::all_t<needle_t>>;
 
+    template <std::ranges::viewable_range needle_t>
+    shiftor_matcher(needle_t &&, iupac_matching) -> shiftor_matcher<std::views::all_t<needle_t>>;
+
 }  // namespace spm
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <optional>
+
+#include <libspm/matcher/iupac_masks.hpp>
 #include <libspm/matcher/seqan_pattern_base.hpp>
 #include <libspm/matcher/seqan_restorable_pattern.hpp>
+#include <libspm/seqan/serialisation.hpp>
 
 namespace seqan2 {
     template <typename needle_t>
@@ -32,6 +36,12 @@ namespace seqan2 {
         constexpr explicit Pattern(needle_t const & needle) : base_type{needle}
         {}
 
+        //!\brief Preprocesses a new needle reusing the allocated table; the state is reset with the next search.
+        constexpr void rebind(needle_t const & needle) {
+            setHost(to_base(*this), needle);
+            _first_find = true;
+        }
+
         template <typename finder_t>
         constexpr bool operator()(finder_t & finder) noexcept {
             initialise(finder);
@@ -97,6 +107,7 @@ namespace spm
         using pattern_type = seqan2::Pattern<compatible_needle_type, Restorable<seqan2::ShiftOr>>;
 
         pattern_type _pattern{};
+        std::optional<iupac_matching> _iupac{};
 
     public:
 
@@ -110,6 +121,17 @@ namespace spm
             _pattern{spm::make_seqan_container(std::views::all((_needle_t &&) needle))}
         {}
 
+        //!\brief Constructs the matcher such that degenerate symbols are matched according to spm::iupac_matching.
+        template <std::ranges::viewable_range _needle_t>
+            requires (!std::same_as<_needle_t, restorable_shiftor_matcher> &&
+                       std::constructible_from<compatible_needle_type, _needle_t>)
+        restorable_shiftor_matcher(_needle_t && needle, iupac_matching const config) :
+            restorable_shiftor_matcher{(_needle_t &&) needle}
+        {
+            _iupac = config;
+            expand_iupac_masks();
+        }
+
         constexpr state_type const & capture() const noexcept {
             return _pattern.capture();
         }
@@ -118,8 +140,28 @@ namespace spm
             _pattern.restore(std::move(state));
         }
 
+        /*!\brief Replaces the needle without constructing a new matcher.
+         *
+         * The preprocessing reuses the table of the previous needle where possible and the search state is reset.
+         * The new needle must be convertible to the needle type of the matcher.
+         */
+        template <std::ranges::viewable_range _needle_t>
+            requires std::constructible_from<needle_t, _needle_t>
+        constexpr void set_needle(_needle_t && needle) {
+            _pattern.rebind(spm::make_seqan_container(needle_t{(_needle_t &&) needle}));
+            expand_iupac_masks();
+        }
+
     private:
 
+        // Folds the configured IUPAC compatibility into the table computed for the current needle.
+        constexpr void expand_iupac_masks() {
+            if (_iupac.has_value())
+                detail::expand_iupac_masks<std::ranges::range_value_t<needle_t>>(
+                    std::span{seqan2::begin(_pattern.table, seqan2::Standard()), seqan2::length(_pattern.table)},
+                    _pattern.blockCount, false, *_iupac);
+        }
+
         constexpr pattern_type & get_pattern() noexcept {
             return _pattern;
         }
@@ -128,4 +170,7 @@ namespace spm
     template <std::ranges::viewable_range needle_t>
     restorable_shiftor_matcher(needle_t &&) -> restorable_shiftor_matcher<std::views::all_t<needle_t>>;
 
+    template <std::ranges::viewable_range needle_t>
+    restorable_shiftor_matcher(needle_t &&, iupac_matching) -> restorable_shiftor_matcher<std::views::all_t<needle_t>>;
+
 }  // namespace spm
@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the search with exact error counts and the stratified reporting of the best hits.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    //!\brief A hit annotated with the exact number of errors of the best alignment ending at its end position.
+    struct scored_hit
+    {
+        std::size_t begin_position{}; //!< The begin position of the hit.
+        std::size_t end_position{}; //!< The end position of the hit (exclusive).
+        std::size_t error_count{}; //!< The edit distance of the hit.
+
+    private:
+
+        constexpr friend bool operator==(scored_hit const &, scored_hit const &) noexcept = default;
+    };
+
+    //!\brief A matcher that exposes the number of errors of the hit it reports last.
+    template <typename matcher_t>
+    concept scored_matcher = window_matcher<matcher_t> && requires (std::remove_reference_t<matcher_t> & matcher)
+    {
+        { matcher.error_count() } -> std::integral;
+    };
+
+    /*!\brief Selects the strata reported by spm::stratified_search.
+     *
+     * Only hits with at most `best + delta` errors are reported, where `best` is the smallest error count of all hits.
+     * The default reports the best stratum only.
+     */
+    struct stratum_policy
+    {
+        std::size_t delta{}; //!< The number of strata reported in addition to the best one.
+
+    private:
+
+        constexpr friend bool operator==(stratum_policy const &, stratum_policy const &) noexcept = default;
+    };
+
+    /*!\brief Searches the haystack once and reports every hit with its exact error count.
+     * \param matcher The matcher configured with the maximal number of errors.
+     * \param haystack The haystack to search.
+     * \param base_offset The position of the first symbol of the haystack within a larger haystack.
+     * \param callback The callback invoked with a spm::scored_hit for every hit.
+     * \returns spm::search_control::stop if the callback stopped the search, otherwise
+     *          spm::search_control::proceed.
+     */
+    template <scored_matcher matcher_t, std::ranges::viewable_range haystack_t, typename callback_t>
+    constexpr search_control scored_search(matcher_t & matcher,
+                                           haystack_t && haystack,
+                                           std::size_t const base_offset,
+                                           callback_t && callback) {
+        return matcher((haystack_t &&) haystack, base_offset, [&] (matcher_hit const & hit) {
+            return detail::invoke_hit_callback(callback,
+                                               scored_hit{.begin_position = hit.begin_position,
+                                                          .end_position = hit.end_position,
+                                                          .error_count = static_cast<std::size_t>(matcher.error_count())});
+        });
+    }
+
+    /*!\brief Collects scored hits and forwards those within the selected strata.
+     *
+     * The collector can be fed with the hits of several searches, e.g. of the chunks of a haystack, and reports the
+     * hits ordered as they were collected once spm::stratum_collector::flush is called. While collecting, hits
+     * that fall out of the selected strata due to a better hit are dropped.
+     */
+    class stratum_collector
+    {
+    private:
+
+        std::vector<scored_hit> _hits{};
+        stratum_policy _policy{};
+        std::size_t _best_error_count{std::numeric_limits<std::size_t>::max()};
+
+    public:
+
+        stratum_collector() = default;
+        explicit stratum_collector(stratum_policy const policy) noexcept : _policy{policy}
+        {}
+
+        void operator()(scored_hit const & hit) {
+            if (hit.error_count < _best_error_count) {
+                _best_error_count = hit.error_count;
+                std::erase_if(_hits, [&] (scored_hit const & other) { return !is_selected(other); });
+            }
+
+            if (is_selected(hit))
+                _hits.push_back(hit);
+        }
+
+        //!\brief The smallest error count of all collected hits or std::numeric_limits<std::size_t>::max().
+        constexpr std::size_t best_error_count() const noexcept {
+            return _best_error_count;
+        }
+
+        //!\brief Reports the selected hits to the callback and resets the collector.
+        template <typename callback_t>
+        void flush(callback_t && callback) {
+            for (scored_hit const & hit : _hits)
+                callback(hit);
+
+            _hits.clear();
+            _best_error_count = std::numeric_limits<std::size_t>::max();
+        }
+
+    private:
+
+        constexpr bool is_selected(scored_hit const & hit) const noexcept {
+            return hit.error_count - std::min(hit.error_count, _best_error_count) <= _policy.delta;
+        }
+    };
+
+    /*!\brief Searches the haystack once with the maximal number of errors and reports the best strata.
+     * \param matcher The matcher configured with the maximal number of errors.
+     * \param haystack The haystack to search.
+     * \param policy The strata to report.
+     * \param callback The callback invoked with a spm::scored_hit for every selected hit.
+     *
+     * Replaces the iterative deepening over the number of errors, which rescans the haystack for every error count,
+     * by a single scan. The hits are reported after the complete haystack has been searched.
+     */
+    template <scored_matcher matcher_t, std::ranges::viewable_range haystack_t, typename callback_t>
+    void stratified_search(matcher_t & matcher,
+                           haystack_t && haystack,
+                           stratum_policy const policy,
+                           callback_t && callback) {
+        stratum_collector collector{policy};
+        spm::scored_search(matcher, (haystack_t &&) haystack, 0, collector);
+        collector.flush((callback_t &&) callback);
+    }
+
+}  // namespace spm
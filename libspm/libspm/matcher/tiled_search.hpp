@@ -0,0 +1,188 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the search of many matchers over a long haystack in cache-sized tiles.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+
+namespace spm
+{
+    //!\brief The default tile size of spm::tiled_search, which fits into the L2 cache of most hosts.
+    inline constexpr std::size_t default_tile_bytes = 256 * 1024;
+
+    namespace detail
+    {
+        //!\brief The number of tiles a matcher group of spm::tiled_search may search ahead of the replay of its hits.
+        inline constexpr std::size_t tiled_search_buffered_tiles = 4;
+    } // namespace detail
+
+    /*!\brief Searches the haystack with every matcher, tile by tile.
+     * \param matchers The restorable matchers; every needle group searches with its own copies.
+     * \param haystack The haystack to search.
+     * \param callback The callback invoked with the index of the matcher and the spm::matcher_hit of every hit.
+     * \param tile_bytes The number of bytes of the haystack that are searched by all matchers of a group at once.
+     * \param thread_count The number of threads used for the search.
+     * \throws Any exception thrown by a matcher or the callback, which is rethrown on the calling thread.
+     *
+     * Searching a haystack that does not fit into the cache with N matchers one after the other streams it N times
+     * from memory. Instead, the matchers are split into one group of consecutive matchers per thread, and every group
+     * loads a tile of `tile_bytes` and runs all its matchers over it before moving on to the next tile. The matchers
+     * continue their state from tile to tile, such that hits spanning a tile boundary are found. Hence, the hits are
+     * exactly those of separate searches of the complete haystack.
+     *
+     * The callback is invoked on the calling thread while the search proceeds, tile by tile in the order of the
+     * haystack. The hits of a tile are reported by matcher index and, for every matcher, in the order of a separate
+     * search. A group searches at most a few tiles ahead of the replay, which bounds the memory of the buffered hits
+     * independently of the haystack size.
+     */
+    template <std::ranges::random_access_range matchers_t,
+              std::ranges::random_access_range haystack_t,
+              typename callback_t>
+        requires std::ranges::sized_range<haystack_t> &&
+                 restorable_matcher<std::ranges::range_value_t<matchers_t> &>
+    void tiled_search(matchers_t const & matchers,
+                      haystack_t const & haystack,
+                      callback_t && callback,
+                      std::size_t const tile_bytes = default_tile_bytes,
+                      std::size_t const thread_count = std::thread::hardware_concurrency()) {
+        using matcher_t = std::ranges::range_value_t<matchers_t>;
+        using hit_list_t = std::vector<std::pair<std::size_t, matcher_hit>>;
+
+        constexpr std::size_t buffered_tiles = detail::tiled_search_buffered_tiles;
+        constexpr std::size_t failed = std::numeric_limits<std::size_t>::max();
+
+        // The hits of the buffered tiles of a group and the number of tiles the group has searched.
+        struct group_state
+        {
+            std::vector<matcher_t> matchers{};
+            std::size_t first_matcher{};
+            std::array<hit_list_t, buffered_tiles> tile_hits{};
+            std::atomic<std::size_t> searched_tiles{};
+            std::exception_ptr exception{};
+        };
+
+        std::size_t const matcher_count = std::ranges::size(matchers);
+        std::size_t const haystack_size = std::ranges::size(haystack);
+        if (matcher_count == 0 || haystack_size == 0)
+            return;
+
+        std::size_t const symbol_bytes = sizeof(std::ranges::range_value_t<haystack_t>);
+        std::size_t const tile_size = std::max<std::size_t>(tile_bytes / symbol_bytes, 1);
+        std::size_t const tile_count = (haystack_size + tile_size - 1) / tile_size;
+        std::size_t const group_count = std::clamp<std::size_t>(thread_count, 1, matcher_count);
+        std::size_t const group_size = (matcher_count + group_count - 1) / group_count;
+
+        std::vector<group_state> groups(group_count);
+        for (std::size_t group = 0; group < group_count; ++group) {
+            groups[group].first_matcher = std::min(group * group_size, matcher_count);
+            std::size_t const last_matcher = std::min(groups[group].first_matcher + group_size, matcher_count);
+            groups[group].matchers.assign(std::ranges::begin(matchers) + groups[group].first_matcher,
+                                          std::ranges::begin(matchers) + last_matcher);
+        }
+
+        auto search_tile = [&] (group_state & state, std::size_t const tile) {
+            std::size_t const tile_begin = tile * tile_size;
+            std::size_t const tile_end = std::min(tile_begin + tile_size, haystack_size);
+            std::ranges::subrange tile_range{std::ranges::begin(haystack) + tile_begin,
+                                             std::ranges::begin(haystack) + tile_end};
+            hit_list_t & hits = state.tile_hits[tile % buffered_tiles];
+            hits.clear();
+            for (std::size_t index = 0; index < state.matchers.size(); ++index) {
+                state.matchers[index](tile_range, tile_begin, [&] (auto const & hit) {
+                    hits.emplace_back(state.first_matcher + index,
+                                      matcher_hit{.begin_position = hit.begin_position,
+                                                  .end_position = hit.end_position});
+                });
+            }
+            // Report the hits of the tile in the order of separate searches, i.e. by matcher and then by position.
+            std::ranges::stable_sort(hits, std::ranges::less{}, [] (auto const & entry) { return entry.first; });
+        };
+
+        auto replay_tile = [&] (group_state const & state, std::size_t const tile) {
+            for (auto const & [matcher_index, hit] : state.tile_hits[tile % buffered_tiles])
+                callback(matcher_index, hit);
+        };
+
+        if (group_count == 1) {
+            for (std::size_t tile = 0; tile < tile_count; ++tile) {
+                search_tile(groups[0], tile);
+                replay_tile(groups[0], tile);
+            }
+            return;
+        }
+
+        // The number of tiles replayed by the calling thread; set to `failed` to cancel the workers.
+        std::atomic<std::size_t> replayed_tiles{};
+
+        auto search_group = [&] (group_state & state) {
+            try {
+                for (std::size_t tile = 0; tile < tile_count; ++tile) {
+                    // Wait until the hits of the tile occupying the buffer slot have been replayed.
+                    std::size_t replayed = replayed_tiles.load(std::memory_order_acquire);
+                    for (; replayed != failed && tile >= replayed + buffered_tiles;
+                         replayed = replayed_tiles.load(std::memory_order_acquire))
+                        replayed_tiles.wait(replayed, std::memory_order_acquire);
+                    if (replayed == failed)
+                        return;
+
+                    search_tile(state, tile);
+                    state.searched_tiles.store(tile + 1, std::memory_order_release);
+                    state.searched_tiles.notify_one();
+                }
+            } catch (...) {
+                state.exception = std::current_exception();
+                state.searched_tiles.store(failed, std::memory_order_release);
+                state.searched_tiles.notify_one();
+            }
+        };
+
+        std::vector<std::jthread> workers{};
+        workers.reserve(group_count);
+        for (group_state & state : groups)
+            workers.emplace_back(search_group, std::ref(state));
+
+        // Replay the hits tile by tile in the order of the groups.
+        try {
+            for (std::size_t tile = 0; tile < tile_count; ++tile) {
+                for (group_state & state : groups) {
+                    std::size_t searched = state.searched_tiles.load(std::memory_order_acquire);
+                    for (; searched <= tile; searched = state.searched_tiles.load(std::memory_order_acquire))
+                        state.searched_tiles.wait(searched, std::memory_order_acquire);
+                    if (searched == failed)
+                        std::rethrow_exception(state.exception);
+
+                    replay_tile(state, tile);
+                }
+                replayed_tiles.store(tile + 1, std::memory_order_release);
+                replayed_tiles.notify_all();
+            }
+        } catch (...) {
+            replayed_tiles.store(failed, std::memory_order_release);
+            replayed_tiles.notify_all();
+            throw; // the workers are joined while unwinding.
+        }
+    }
+
+}  // namespace spm
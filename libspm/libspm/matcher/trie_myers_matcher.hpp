@@ -0,0 +1,324 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the approximate multi-needle matcher sharing the computation of common needle prefixes.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/core/concept/cereal.hpp>
+
+#if SEQAN3_WITH_CEREAL
+#include <cereal/types/vector.hpp>
+#endif
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/search_control.hpp>
+
+namespace spm
+{
+    //!\brief A hit of a multi-needle matcher tagged by the index of the needle.
+    struct needle_hit
+    {
+        std::size_t needle_id{}; //!< The index of the needle in the needle collection.
+        std::size_t begin_position{}; //!< The begin position of the hit.
+        std::size_t end_position{}; //!< The end position of the hit (exclusive).
+        std::size_t error_count{}; //!< The edit distance of the hit.
+
+    private:
+
+        constexpr friend bool operator==(needle_hit const &, needle_hit const &) noexcept = default;
+    };
+
+    /*!\brief The bit-parallel algorithm of Myers for many needles organised in a trie.
+     * \tparam alphabet_t The alphabet of the needles and the haystack.
+     *
+     * The needles are stored in a compressed trie whose edges hold at most 64 symbols. Every node covers the rows of
+     * the DP column of the symbols on its incoming edge and is advanced as one block of the block-based algorithm of
+     * Myers, receiving the horizontal difference of the last row of its parent. Hence, the rows of a prefix shared by
+     * several needles are computed only once per haystack position, and only the diverging suffixes are processed
+     * per needle. A spm::needle_hit is reported for every needle and end position with at most the given number of
+     * errors. The state of all trie nodes can be captured, such that the matcher models spm::restorable_matcher.
+     */
+    template <typename alphabet_t>
+    class trie_myers_matcher
+    {
+    private:
+
+        using word_type = uint64_t;
+
+        static constexpr std::size_t word_size = std::numeric_limits<word_type>::digits;
+        static constexpr std::size_t sigma = seqan3::alphabet_size<alphabet_t>;
+        static constexpr std::size_t no_parent = std::numeric_limits<std::size_t>::max();
+
+    public:
+
+        //!\brief The search state of a trie node.
+        struct node_state
+        {
+            word_type vp{};
+            word_type vn{};
+            std::size_t score{}; //!< The score of the last row of the node.
+
+            template <seqan3::cereal_archive archive_t>
+            void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+                archive(vp, vn, score);
+            }
+
+        private:
+
+            constexpr friend bool operator==(node_state const &, node_state const &) noexcept = default;
+        };
+
+        using state_type = std::vector<node_state>;
+
+    private:
+
+        // The nodes are stored in an order in which every parent precedes its children.
+        std::vector<word_type> _masks{}; // sigma masks per node.
+        std::vector<std::size_t> _parents{};
+        std::vector<std::size_t> _last_rows{}; // the row of the last symbol of a node within its block.
+        std::vector<std::size_t> _depths{}; // the number of needle symbols up to and including a node.
+        std::vector<std::size_t> _reporting_nodes{}; // the nodes at which at least one needle ends.
+        std::vector<std::size_t> _needle_offsets{}; // the needles of reporting node i are [offsets[i], offsets[i+1]).
+        std::vector<std::size_t> _needle_ids{};
+        std::vector<std::size_t> _needle_sizes{};
+        std::vector<int8_t> _horizontal_deltas{}; // scratch: the horizontal difference leaving every node.
+        state_type _state{};
+        std::size_t _max_error_count{};
+
+    public:
+
+        trie_myers_matcher() = delete;
+        /*!\brief Constructs the trie of the given needles.
+         * \param needles The collection of needles; all needles must be non-empty.
+         * \param max_error_count The maximal number of errors of a hit.
+         */
+        template <std::ranges::viewable_range needles_t>
+            requires (!std::same_as<std::remove_cvref_t<needles_t>, trie_myers_matcher> &&
+                      std::ranges::forward_range<std::ranges::range_reference_t<needles_t>>)
+        explicit trie_myers_matcher(needles_t && needles, std::size_t const max_error_count = 0) :
+            _max_error_count{max_error_count}
+        {
+            build_trie(needles);
+            _horizontal_deltas.resize(_parents.size());
+            _state = initial_state();
+        }
+
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack, callback_t && callback) {
+            return (*this)((haystack_t &&) haystack, 0, (callback_t &&) callback);
+        }
+
+        //!\brief Searches a part of a larger haystack starting at `base_offset`.
+        template <std::ranges::viewable_range haystack_t, typename callback_t>
+        constexpr search_control operator()(haystack_t && haystack,
+                                            std::size_t const base_offset,
+                                            callback_t && callback) {
+            std::size_t const node_count = _parents.size();
+            std::size_t end_position = base_offset;
+            for (auto && symbol : haystack) {
+                std::size_t const rank = seqan3::to_rank(symbol);
+                for (std::size_t node = 0; node < node_count; ++node) {
+                    std::size_t const parent = _parents[node];
+                    int const horizontal_delta_in = (parent == no_parent) ? 0 : _horizontal_deltas[parent];
+                    _horizontal_deltas[node] = advance_block(node, _masks[node * sigma + rank], horizontal_delta_in);
+                }
+                ++end_position;
+
+                for (std::size_t index = 0; index < _reporting_nodes.size(); ++index) {
+                    std::size_t const error_count = _state[_reporting_nodes[index]].score;
+                    if (error_count > _max_error_count)
+                        continue;
+
+                    for (std::size_t offset = _needle_offsets[index]; offset < _needle_offsets[index + 1]; ++offset) {
+                        std::size_t const needle_id = _needle_ids[offset];
+                        std::size_t const window = _needle_sizes[needle_id] + _max_error_count;
+                        needle_hit const hit{.needle_id = needle_id,
+                                             .begin_position = end_position - std::min(end_position, window),
+                                             .end_position = end_position,
+                                             .error_count = error_count};
+                        if (detail::invoke_hit_callback(callback, hit) == search_control::stop)
+                            return search_control::stop;
+                    }
+                }
+            }
+            return search_control::proceed;
+        }
+
+        //!\brief The number of needles.
+        constexpr std::size_t needle_count() const noexcept {
+            return _needle_sizes.size();
+        }
+
+        //!\brief The number of trie nodes, i.e. the number of blocks advanced per haystack symbol.
+        constexpr std::size_t node_count() const noexcept {
+            return _parents.size();
+        }
+
+        constexpr state_type const & capture() const noexcept {
+            return _state;
+        }
+
+        constexpr void restore(state_type const & state) {
+            assert(state.size() == _state.size());
+            _state = state;
+        }
+
+        //!\brief Serialises the trie and the state of all nodes.
+        template <seqan3::cereal_archive archive_t>
+        void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive) {
+            archive(_masks, _parents, _last_rows, _depths, _reporting_nodes, _needle_offsets, _needle_ids);
+            archive(_needle_sizes, _state, _max_error_count);
+            _horizontal_deltas.resize(_parents.size());
+        }
+
+    private:
+
+        // The block advance of Myers (1999) for a block receiving the horizontal difference of the row above it.
+        constexpr int advance_block(std::size_t const node, word_type eq, int const horizontal_delta_in) noexcept {
+            node_state & state = _state[node];
+            word_type const xv = eq | state.vn;
+            if (horizontal_delta_in < 0)
+                eq |= 1;
+
+            word_type const xh = (((eq & state.vp) + state.vp) ^ state.vp) | eq;
+            word_type hp = state.vn | ~(xh | state.vp);
+            word_type hn = state.vp & xh;
+
+            word_type const hp_last = (hp >> _last_rows[node]) & 1;
+            word_type const hn_last = (hn >> _last_rows[node]) & 1;
+            state.score += hp_last;
+            state.score -= hn_last;
+
+            hp <<= 1;
+            hn <<= 1;
+            if (horizontal_delta_in < 0)
+                hn |= 1;
+            else if (horizontal_delta_in > 0)
+                hp |= 1;
+
+            state.vp = hn | ~(xv | hp);
+            state.vn = hp & xv;
+            return static_cast<int>(hp_last) - static_cast<int>(hn_last);
+        }
+
+        state_type initial_state() const {
+            state_type state(_parents.size());
+            for (std::size_t node = 0; node < state.size(); ++node)
+                state[node] = node_state{.vp = ~word_type{0}, .vn = 0, .score = _depths[node]};
+            return state;
+        }
+
+        template <typename needles_t>
+        void build_trie(needles_t & needles) {
+            // First build the uncompressed trie with one node per symbol; node 0 is the root.
+            struct symbol_node
+            {
+                std::vector<std::size_t> children = std::vector<std::size_t>(sigma, no_parent);
+                std::vector<std::size_t> needle_ids{};
+                std::size_t rank{};
+                std::size_t child_count{};
+            };
+
+            std::vector<symbol_node> symbol_nodes(1);
+            for (auto && needle : needles) {
+                assert(!std::ranges::empty(needle));
+
+                std::size_t current = 0;
+                std::size_t needle_size = 0;
+                for (auto && symbol : needle) {
+                    std::size_t const rank = seqan3::to_rank(symbol);
+                    if (symbol_nodes[current].children[rank] == no_parent) {
+                        symbol_nodes[current].children[rank] = symbol_nodes.size();
+                        ++symbol_nodes[current].child_count;
+                        symbol_nodes.push_back(symbol_node{.rank = rank});
+                    }
+                    current = symbol_nodes[current].children[rank];
+                    ++needle_size;
+                }
+                symbol_nodes[current].needle_ids.push_back(_needle_sizes.size());
+                _needle_sizes.push_back(needle_size);
+            }
+
+            // Then merge unary paths into nodes of at most one word, ending a node where a needle ends.
+            struct pending_node
+            {
+                std::size_t symbol_node{};
+                std::size_t parent{};
+            };
+
+            std::vector<pending_node> pending{};
+            for (std::size_t rank = sigma; rank > 0; --rank)
+                if (std::size_t const child = symbol_nodes[0].children[rank - 1]; child != no_parent)
+                    pending.push_back(pending_node{.symbol_node = child, .parent = no_parent});
+
+            _needle_offsets.push_back(0);
+            while (!pending.empty()) {
+                pending_node const next = pending.back();
+                pending.pop_back();
+
+                std::size_t const node = _parents.size();
+                _parents.push_back(next.parent);
+                _masks.resize(_masks.size() + sigma, 0);
+
+                std::size_t current = next.symbol_node;
+                std::size_t row = 0;
+                while (true) {
+                    _masks[node * sigma + symbol_nodes[current].rank] |= word_type{1} << row;
+                    if (!symbol_nodes[current].needle_ids.empty() ||
+                        symbol_nodes[current].child_count != 1 ||
+                        row + 1 == word_size)
+                        break;
+
+                    current = *std::ranges::find_if(symbol_nodes[current].children, [] (std::size_t const child) {
+                        return child != no_parent;
+                    });
+                    ++row;
+                }
+
+                _last_rows.push_back(row);
+                _depths.push_back(((next.parent == no_parent) ? 0 : _depths[next.parent]) + row + 1);
+
+                if (!symbol_nodes[current].needle_ids.empty()) {
+                    _reporting_nodes.push_back(node);
+                    _needle_ids.insert(_needle_ids.end(),
+                                       symbol_nodes[current].needle_ids.begin(),
+                                       symbol_nodes[current].needle_ids.end());
+                    _needle_offsets.push_back(_needle_ids.size());
+                }
+
+                for (std::size_t rank = sigma; rank > 0; --rank)
+                    if (std::size_t const child = symbol_nodes[current].children[rank - 1]; child != no_parent)
+                        pending.push_back(pending_node{.symbol_node = child, .parent = node});
+            }
+        }
+
+        constexpr friend std::size_t tag_invoke(std::tag_t<spm::window_size>, trie_myers_matcher const & me) noexcept {
+            return me._needle_sizes.empty() ? 0 : std::ranges::max(me._needle_sizes) + me._max_error_count;
+        }
+    };
+
+    template <std::ranges::viewable_range needles_t>
+    trie_myers_matcher(needles_t &&)
+        -> trie_myers_matcher<std::ranges::range_value_t<std::ranges::range_reference_t<needles_t>>>;
+
+    template <std::ranges::viewable_range needles_t>
+    trie_myers_matcher(needles_t &&, std::size_t)
+        -> trie_myers_matcher<std::ranges::range_value_t<std::ranges::range_reference_t<needles_t>>>;
+
+}  // namespace spm
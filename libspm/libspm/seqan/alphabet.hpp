@@ -13,7 +13,9 @@
 #pragma once
 
 #include <concepts>
+#include <cstdint>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -28,9 +30,24 @@
 #include <seqan3/alphabet/detail/debug_stream_alphabet.hpp>
 #include <seqan3/utility/math.hpp>
 
+#include <libspm/seqan/rank_conversion.hpp>
 #include <libspm/std/tag_invoke.hpp>
 namespace seqan2
 {
+    namespace detail
+    {
+        // Converts the char through the constexpr rank table if the alphabet provides one.
+        template <seqan3::alphabet alphabet_t>
+        constexpr alphabet_t assign_char(seqan3::alphabet_char_t<alphabet_t> const c) noexcept
+        {
+            if constexpr (spm::rank_convertible_alphabet<alphabet_t>)
+                return seqan3::assign_rank_to(spm::char_to_rank_table<alphabet_t>[static_cast<uint8_t>(c)],
+                                              alphabet_t{});
+            else
+                return seqan3::assign_char_to(c, alphabet_t{});
+        }
+    } // namespace detail
+
     template <seqan3::alphabet alphabet_t>
     struct alphabet_adaptor
     {
@@ -41,7 +58,7 @@ namespace seqan2
         template <typename char_t>
             requires std::same_as<seqan3::alphabet_char_t<alphabet_t>, char_t> &&
                      requires { seqan3::assign_char_to(char_t{}, alphabet_t{}); }
-        constexpr explicit alphabet_adaptor(char_t c) : _symbol{seqan3::assign_char_to(c, alphabet_t{})}
+        constexpr explicit alphabet_adaptor(char_t c) : _symbol{detail::assign_char<alphabet_t>(c)}
         {}
 
         template <std::integral rank_t>
@@ -111,6 +128,16 @@ namespace seqan2
         static constexpr Type VALUE = seqan3::detail::ceil_log2(seqan3::alphabet_size<alphabet_t>);
     };
 
+    // Converts between adapted alphabets as done by seqan2::convert, e.g. for a haystack symbol searched with a needle
+    // of a different alphabet; the conversion follows the explicit conversion of the seqan3 alphabets.
+    template <typename target_alphabet_t, typename spec_t, typename source_alphabet_t>
+        requires seqan3::explicitly_convertible_to<source_alphabet_t, target_alphabet_t>
+    constexpr alphabet_adaptor<target_alphabet_t> convertImpl(Convert<alphabet_adaptor<target_alphabet_t>, spec_t> const,
+                                                              alphabet_adaptor<source_alphabet_t> const & source) noexcept
+    {
+        return alphabet_adaptor<target_alphabet_t>{source};
+    }
+
 } // namespace seqan2
 
 namespace spm
@@ -128,9 +155,8 @@ namespace spm
     {
         std::vector<dna4> r;
         r.reserve(std::max<std::size_t>(n, 16));
-        std::ranges::copy(std::string_view{s, n} | std::views::transform([] (char c) {
-            return dna4{c};
-        }), std::back_inserter(r));
+        r.resize(n);
+        spm::to_symbols<dna4>(std::span{s, n}, r);
         return r;
     }
 
@@ -143,9 +169,8 @@ namespace spm
     {
         std::vector<dna5> r;
         r.reserve(std::max<std::size_t>(n, 16));
-        std::ranges::copy(std::string_view{s, n} | std::views::transform([] (char c) {
-            return dna5{c};
-        }), std::back_inserter(r));
+        r.resize(n);
+        spm::to_symbols<dna5>(std::span{s, n}, r);
         return r;
     }
 } // namespace spm
@@ -303,7 +328,7 @@ namespace seqan3::custom
 
         constexpr static alphabet_t & assign_char_to(char const c, alphabet_t & a) noexcept
         {
-            seqan3::assign_char_to(c, a._symbol);
+            a._symbol = seqan2::detail::assign_char<wrapped_t>(c);
             return a;
         }
 
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <ranges>
 #include <type_traits>
@@ -89,6 +90,87 @@ namespace spm
         }
     };
 
+    /*!\brief Specialisation for contiguous views that do not own their elements, e.g. a std::span or a reference to a
+     *        std::vector.
+     *
+     * Stores the pointer to the first element and the size directly, such that the element access avoids any
+     * indirection through the wrapped view. The standard and rooted iterators seen by seqan2 are raw pointers and
+     * adaptors of raw pointers, as for seqan2's own strings.
+     */
+    template <typename range_t>
+        requires (std::ranges::contiguous_range<range_t> &&
+                  std::ranges::sized_range<range_t> &&
+                  std::ranges::borrowed_range<range_t>)
+    class seqan_container_adapter<range_t>
+    {
+    private:
+        using element_type = std::remove_reference_t<std::ranges::range_reference_t<range_t>>;
+
+        element_type * _data{nullptr};
+        std::size_t _size{};
+
+    public:
+        using value_type = std::ranges::range_value_t<range_t>;
+        using reference = element_type &;
+        using const_reference = element_type const &;
+        using iterator = element_type *;
+        using const_iterator = element_type const *;
+        using size_type = std::make_unsigned_t<std::ranges::range_difference_t<range_t>>;
+        using difference_type = std::ranges::range_difference_t<range_t>;
+
+        seqan_container_adapter() = default;
+        explicit seqan_container_adapter(range_t range) noexcept :
+            _data{std::ranges::data(range)},
+            _size{std::ranges::size(range)}
+        {
+        }
+
+        seqan_container_adapter(seqan_container_adapter const &) = default;
+        seqan_container_adapter(seqan_container_adapter &&) = default;
+        seqan_container_adapter & operator=(seqan_container_adapter const &) = default;
+        seqan_container_adapter & operator=(seqan_container_adapter &&) = default;
+
+        constexpr reference operator[](difference_type const index) noexcept
+        {
+            return _data[index];
+        }
+
+        constexpr const_reference operator[](difference_type const index) const noexcept
+        {
+            return _data[index];
+        }
+
+        constexpr iterator begin() noexcept
+        {
+            return _data;
+        }
+
+        constexpr const_iterator begin() const noexcept
+        {
+            return _data;
+        }
+
+        constexpr iterator end() noexcept
+        {
+            return _data + _size;
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+            return _data + _size;
+        }
+
+        constexpr size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+    };
+
     template <std::ranges::view range_t>
         requires (std::ranges::common_range<range_t> && std::ranges::random_access_range<range_t>)
     constexpr auto make_seqan_container(range_t range) noexcept
@@ -114,6 +196,13 @@ namespace seqan2
     {
         template <typename range_t>
         using container_t = spm::seqan_container_adapter<range_t>;
+
+        // The adapters of contiguous views iterate with raw pointers, which seqan2 handles like the iterators of its
+        // own strings. All other adapters are iterated through the std iterator adaptor.
+        template <typename adapter_t, typename std_iterator_t>
+        using standard_iterator_t = std::conditional_t<std::is_pointer_v<std_iterator_t>,
+                                                       std_iterator_t,
+                                                       Iter<adapter_t, StdIteratorAdaptor>>;
     } // namespace detail
 
     template <typename range_t>
@@ -169,37 +258,26 @@ namespace seqan2
     template <typename range_t>
     struct Iterator<spm::seqan_container_adapter<range_t>, Standard>
     {
-        typedef Iter<detail::container_t<range_t>, StdIteratorAdaptor> Type;
+        using Type = detail::standard_iterator_t<detail::container_t<range_t>,
+                                                 typename detail::container_t<range_t>::iterator>;
     };
     template <typename range_t>
     struct Iterator<spm::seqan_container_adapter<range_t> const, Standard>
     {
-        typedef Iter<detail::container_t<range_t> const, StdIteratorAdaptor> Type;
+        using Type = detail::standard_iterator_t<detail::container_t<range_t> const,
+                                                 typename detail::container_t<range_t>::const_iterator>;
     };
     template <typename range_t>
     struct Iterator<spm::seqan_container_adapter<range_t>, Rooted>
     {
-
-        typedef Iter<detail::container_t<range_t>,
-                     AdaptorIterator<
-                        Iter<
-                            detail::container_t<range_t>,
-                            StdIteratorAdaptor
-                        >
-                    >
-                > Type;
+        using Type = Iter<detail::container_t<range_t>,
+                          AdaptorIterator<typename Iterator<detail::container_t<range_t>, Standard>::Type>>;
     };
     template <typename range_t>
     struct Iterator<spm::seqan_container_adapter<range_t> const, Rooted>
     {
-        typedef Iter<detail::container_t<range_t> const,
-                     AdaptorIterator<
-                        Iter<
-                            detail::container_t<range_t> const,
-                            StdIteratorAdaptor
-                        >
-                    >
-                > Type;
+        using Type = Iter<detail::container_t<range_t> const,
+                          AdaptorIterator<typename Iterator<detail::container_t<range_t> const, Standard>::Type>>;
     };
 
     template <typename range_t>
@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides constexpr char to rank tables and a vectorised bulk conversion of text into ranks.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+#include <seqan3/alphabet/concept.hpp>
+
+namespace spm
+{
+    //!\brief An alphabet whose char conversion can be evaluated at compile time and whose ranks fit into an uint8_t.
+    template <typename alphabet_t>
+    concept rank_convertible_alphabet = seqan3::detail::writable_constexpr_alphabet<alphabet_t> &&
+                                        (seqan3::alphabet_size<alphabet_t> <= 256);
+
+    /*!\brief Maps every char to the rank of the alphabet symbol it is converted to.
+     *
+     * The table is generated at compile time from seqan3::assign_char_to, such that the conversion of invalid
+     * characters, e.g. to 'A' for dna4 and 'N' for dna5, is preserved.
+     */
+    template <rank_convertible_alphabet alphabet_t>
+    inline constexpr std::array<uint8_t, 256> char_to_rank_table = [] () {
+        std::array<uint8_t, 256> table{};
+        for (std::size_t c = 0; c < table.size(); ++c)
+            table[c] = seqan3::to_rank(seqan3::assign_char_to(static_cast<char>(c), alphabet_t{}));
+        return table;
+    }();
+
+    namespace detail
+    {
+        // The letters of all nucleotide alphabets are within [0x40, 0x80). The table of every high nibble within this
+        // range is indexed by the low nibble of the character.
+        template <rank_convertible_alphabet alphabet_t>
+        inline constexpr std::array<std::array<uint8_t, 16>, 4> letter_rank_tables = [] () {
+            std::array<std::array<uint8_t, 16>, 4> tables{};
+            for (std::size_t high = 0; high < tables.size(); ++high)
+                for (std::size_t low = 0; low < 16; ++low)
+                    tables[high][low] = char_to_rank_table<alphabet_t>[(high + 4) * 16 + low];
+            return tables;
+        }();
+
+        template <rank_convertible_alphabet alphabet_t>
+        constexpr void to_rank_scalar(char const * text, uint8_t * ranks, std::size_t const count) noexcept {
+            for (std::size_t index = 0; index < count; ++index)
+                ranks[index] = char_to_rank_table<alphabet_t>[static_cast<uint8_t>(text[index])];
+        }
+    } // namespace detail
+
+    /*!\brief Converts a text into the ranks of the given alphabet.
+     * \tparam alphabet_t The alphabet whose ranks are computed, e.g. spm::dna4.
+     * \param text The text to convert.
+     * \param ranks The output buffer; must be at least as large as the text.
+     *
+     * Uses a shuffle-table lookup on blocks of 32 (AVX2) or 16 (SSSE3) characters if the target supports it.
+     * Blocks containing characters outside of the letter range as well as the remaining characters are converted
+     * with the scalar table lookup. The result equals the conversion through seqan3::assign_char_to.
+     */
+    template <rank_convertible_alphabet alphabet_t>
+    inline void to_rank(std::span<char const> const text, std::span<uint8_t> const ranks) noexcept {
+        assert(ranks.size() >= text.size());
+
+        char const * text_it = text.data();
+        uint8_t * rank_it = ranks.data();
+        std::size_t remaining = text.size();
+
+        [[maybe_unused]] auto const & tables = detail::letter_rank_tables<alphabet_t>;
+
+#if defined(__AVX2__)
+        {
+            __m256i const low_mask = _mm256_set1_epi8(0x0f);
+            __m256i const range_mask = _mm256_set1_epi8(static_cast<char>(0xc0));
+            __m256i const range_value = _mm256_set1_epi8(0x40);
+            __m256i lookup[4];
+            for (std::size_t high = 0; high < 4; ++high)
+                lookup[high] = _mm256_broadcastsi128_si256(
+                                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(tables[high].data())));
+
+            for (; remaining >= 32; remaining -= 32, text_it += 32, rank_it += 32) {
+                __m256i const chars = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(text_it));
+                __m256i const in_range = _mm256_cmpeq_epi8(_mm256_and_si256(chars, range_mask), range_value);
+                if (_mm256_movemask_epi8(in_range) != -1) {
+                    detail::to_rank_scalar<alphabet_t>(text_it, rank_it, 32);
+                    continue;
+                }
+
+                __m256i const low = _mm256_and_si256(chars, low_mask);
+                __m256i const high = _mm256_and_si256(_mm256_srli_epi16(chars, 4), _mm256_set1_epi8(0x03));
+                __m256i result = _mm256_setzero_si256();
+                for (int h = 0; h < 4; ++h) {
+                    __m256i const selected = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(h)));
+                    result = _mm256_or_si256(result, _mm256_and_si256(selected, _mm256_shuffle_epi8(lookup[h], low)));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(rank_it), result);
+            }
+        }
+#elif defined(__SSSE3__)
+        {
+            __m128i const low_mask = _mm_set1_epi8(0x0f);
+            __m128i const range_mask = _mm_set1_epi8(static_cast<char>(0xc0));
+            __m128i const range_value = _mm_set1_epi8(0x40);
+            __m128i lookup[4];
+            for (std::size_t high = 0; high < 4; ++high)
+                lookup[high] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(tables[high].data()));
+
+            for (; remaining >= 16; remaining -= 16, text_it += 16, rank_it += 16) {
+                __m128i const chars = _mm_loadu_si128(reinterpret_cast<__m128i const *>(text_it));
+                __m128i const in_range = _mm_cmpeq_epi8(_mm_and_si128(chars, range_mask), range_value);
+                if (_mm_movemask_epi8(in_range) != 0xffff) {
+                    detail::to_rank_scalar<alphabet_t>(text_it, rank_it, 16);
+                    continue;
+                }
+
+                __m128i const low = _mm_and_si128(chars, low_mask);
+                __m128i const high = _mm_and_si128(_mm_srli_epi16(chars, 4), _mm_set1_epi8(0x03));
+                __m128i result = _mm_setzero_si128();
+                for (int h = 0; h < 4; ++h) {
+                    __m128i const selected = _mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(h)));
+                    result = _mm_or_si128(result, _mm_and_si128(selected, _mm_shuffle_epi8(lookup[h], low)));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(rank_it), result);
+            }
+        }
+#endif
+
+        detail::to_rank_scalar<alphabet_t>(text_it, rank_it, remaining);
+    }
+
+    /*!\brief Converts a text into symbols of the given alphabet.
+     * \tparam alphabet_t The alphabet of the symbols, e.g. spm::dna4.
+     * \param text The text to convert.
+     * \param symbols The output buffer; must be at least as large as the text.
+     *
+     * The text is converted block-wise with spm::to_rank and the ranks are assigned to the symbols.
+     */
+    template <rank_convertible_alphabet alphabet_t>
+    inline void to_symbols(std::span<char const> const text, std::span<alphabet_t> const symbols) noexcept {
+        assert(symbols.size() >= text.size());
+
+        std::array<uint8_t, 1024> ranks;
+        for (std::size_t begin = 0; begin < text.size(); begin += ranks.size()) {
+            std::size_t const count = std::min(ranks.size(), text.size() - begin);
+            spm::to_rank<alphabet_t>(text.subspan(begin, count), ranks);
+            for (std::size_t index = 0; index < count; ++index)
+                seqan3::assign_rank_to(ranks[index], symbols[begin + index]);
+        }
+    }
+
+}  // namespace spm
@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the cereal serialisation of the seqan2 types holding the state of the restorable matchers.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <seqan/find.h>
+
+#include <seqan3/core/concept/cereal.hpp>
+
+namespace seqan2
+{
+    template <seqan3::cereal_output_archive archive_t, typename value_t, typename spec_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & archive, String<value_t, spec_t> const & string)
+    {
+        archive(static_cast<uint64_t>(length(string)));
+        for (std::size_t index = 0; index < length(string); ++index)
+            archive(string[index]);
+    }
+
+    template <seqan3::cereal_input_archive archive_t, typename value_t, typename spec_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & archive, String<value_t, spec_t> & string)
+    {
+        uint64_t string_length{};
+        archive(string_length);
+        resize(string, string_length, Exact());
+        for (std::size_t index = 0; index < length(string); ++index)
+            archive(string[index]);
+    }
+
+    // The state of the Myers pattern; the blocks of long needles are held by the separately allocated large state.
+    template <seqan3::cereal_output_archive archive_t,
+              typename needle_t,
+              typename spec_t,
+              typename has_state_t,
+              typename find_begin_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & archive,
+                                   PatternState_<needle_t, Myers<spec_t, has_state_t, find_begin_t>> const & state)
+    {
+        bool const has_large_state = state.largeState != nullptr;
+        archive(state.VP0, state.VN0, state.errors, state.maxErrors, has_large_state);
+        if (has_large_state)
+            archive(state.largeState->lastBlock, state.largeState->VP, state.largeState->VN);
+    }
+
+    template <seqan3::cereal_input_archive archive_t,
+              typename needle_t,
+              typename spec_t,
+              typename has_state_t,
+              typename find_begin_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & archive,
+                                   PatternState_<needle_t, Myers<spec_t, has_state_t, find_begin_t>> & state)
+    {
+        using large_state_t = std::remove_pointer_t<decltype(state.largeState)>;
+
+        bool has_large_state{};
+        archive(state.VP0, state.VN0, state.errors, state.maxErrors, has_large_state);
+        if (has_large_state) {
+            if (state.largeState == nullptr)
+                state.largeState = new large_state_t{};
+
+            archive(state.largeState->lastBlock, state.largeState->VP, state.largeState->VN);
+        } else {
+            delete state.largeState;
+            state.largeState = nullptr;
+        }
+    }
+} // namespace seqan2
@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/jst/jst_search.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+
+using spm::operator""_dna4;
+
+struct jst_search_test : public ::testing::TestWithParam<std::size_t> {
+    using sequence_t = std::vector<spm::dna4>;
+    using tree_t = spm::journaled_sequence_tree<spm::dna4>;
+    using variant_t = typename tree_t::variant_type;
+    using hit_set_t = std::set<std::pair<std::size_t, std::size_t>>; // (haplotype, end position in haplotype)
+
+                                      //0         1         2         3         4
+                                      //012345678901234567890123456789012345678901234
+    sequence_t reference = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t haplotype_count = 5;
+
+    spm::coverage make_coverage(std::initializer_list<std::size_t> haplotypes) const {
+        spm::coverage coverage(haplotype_count);
+        for (std::size_t haplotype : haplotypes)
+            coverage.set(haplotype);
+        return coverage;
+    }
+
+    tree_t make_tree() const {
+        tree_t tree{reference, haplotype_count};
+        tree.insert(variant_t{.position = 11, .deletion_length = 1, .insertion = "T"_dna4, .coverage = make_coverage({0, 2})});
+        tree.insert(variant_t{.position = 9, .deletion_length = 0, .insertion = "GCA"_dna4, .coverage = make_coverage({1})});
+        tree.insert(variant_t{.position = 13, .deletion_length = 3, .insertion = ""_dna4, .coverage = make_coverage({1, 3})});
+        tree.insert(variant_t{.position = 22, .deletion_length = 1, .insertion = "A"_dna4, .coverage = make_coverage({3})});
+        tree.insert(variant_t{.position = 22, .deletion_length = 0, .insertion = "CACG"_dna4, .coverage = make_coverage({2})});
+        tree.insert(variant_t{.position = 33, .deletion_length = 2, .insertion = "CGCACG"_dna4, .coverage = make_coverage({0, 1, 3})});
+        tree.insert(variant_t{.position = 44, .deletion_length = 0, .insertion = "GCACG"_dna4, .coverage = make_coverage({4})});
+        return tree;
+    }
+
+    static sequence_t make_haplotype(tree_t const & tree, std::size_t const haplotype) {
+        sequence_t sequence{};
+        std::size_t reference_position{};
+        for (variant_t const & variant : tree.variants()) {
+            if (!variant.coverage.test(haplotype))
+                continue;
+            sequence.insert(sequence.end(),
+                            tree.reference().begin() + reference_position,
+                            tree.reference().begin() + variant.position);
+            sequence.insert(sequence.end(), variant.insertion.begin(), variant.insertion.end());
+            reference_position = variant.position + variant.deletion_length;
+        }
+        sequence.insert(sequence.end(), tree.reference().begin() + reference_position, tree.reference().end());
+        return sequence;
+    }
+
+    // Translates a hit in path coordinates into the coordinates of the given haplotype.
+    static std::size_t to_haplotype_position(tree_t const & tree, spm::jst_hit const & hit, std::size_t const haplotype) {
+        std::ptrdiff_t shift{};
+        auto const & variants = tree.variants();
+        for (std::size_t index = 0; index < variants.size(); ++index) {
+            variant_t const & variant = variants[index];
+            bool const precedes = (hit.branch_variant == spm::jst_hit::reference_path)
+                                ? variant.position < hit.end_position
+                                : static_cast<std::ptrdiff_t>(index) < hit.branch_variant;
+            if (variant.coverage.test(haplotype) && precedes)
+                shift += std::ranges::ssize(variant.insertion) - static_cast<std::ptrdiff_t>(variant.deletion_length);
+        }
+        return hit.end_position + shift;
+    }
+
+    hit_set_t expected_hits(tree_t const & tree, std::size_t const errors) const {
+        hit_set_t expected{};
+        for (std::size_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+            sequence_t const haplotype_sequence = make_haplotype(tree, haplotype);
+            spm::restorable_myers_matcher matcher{needle, errors};
+            matcher(haplotype_sequence, [&] (auto const & finder) {
+                expected.emplace(haplotype, seqan2::endPosition(finder));
+            });
+        }
+        return expected;
+    }
+};
+
+TEST_F(jst_search_test, concept_tests) {
+    EXPECT_TRUE(spm::sequence_tree<tree_t>);
+    EXPECT_TRUE(spm::traversable_variant<variant_t>);
+}
+
+TEST_F(jst_search_test, sorted_variants) {
+    tree_t tree = make_tree();
+    EXPECT_TRUE(std::ranges::is_sorted(tree.variants(), std::ranges::less{}, [] (variant_t const & variant) {
+        return std::pair{variant.position, variant.deletion_length};
+    }));
+}
+
+TEST_F(jst_search_test, reference_only) {
+    tree_t tree{reference, haplotype_count};
+    spm::restorable_myers_matcher matcher{needle, 1u};
+
+    std::vector<std::size_t> actual_positions{};
+    spm::jst_search(tree, matcher, [&] (spm::jst_hit const & hit, spm::coverage const & coverage) {
+        EXPECT_EQ(hit.branch_variant, spm::jst_hit::reference_path);
+        EXPECT_EQ(coverage.count(), haplotype_count);
+        actual_positions.push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{13,14,15,24,25,26,35,36,37}));
+}
+
+TEST_P(jst_search_test, all_haplotypes) {
+    std::size_t const errors = GetParam();
+    tree_t tree = make_tree();
+    spm::restorable_myers_matcher matcher{needle, errors};
+
+    hit_set_t actual{};
+    spm::jst_search(tree, matcher, [&] (spm::jst_hit const & hit, spm::coverage const & coverage) {
+        EXPECT_TRUE(coverage.any());
+        for (std::size_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+            if (coverage.test(haplotype)) // every hit of a haplotype must be reported exactly once.
+                EXPECT_TRUE(actual.emplace(haplotype, to_haplotype_position(tree, hit, haplotype)).second);
+        }
+    });
+    EXPECT_EQ(actual, expected_hits(tree, errors));
+}
+
+INSTANTIATE_TEST_SUITE_P(error_counts, jst_search_test, ::testing::Values(0u, 1u, 2u));
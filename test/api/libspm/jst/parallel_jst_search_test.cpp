@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/jst/jst_search.hpp>
+#include <libspm/jst/parallel_jst_search.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+
+using spm::operator""_dna4;
+
+// A restorable matcher failing as soon as it searches a part of the tree.
+struct failing_matcher {
+    constexpr std::size_t window_size() const noexcept { return 5; }
+    constexpr std::size_t capture() const noexcept { return 0; }
+    constexpr void restore(std::size_t) noexcept {}
+
+    template <typename haystack_t, typename callback_t>
+    void operator()(haystack_t &&, std::size_t, callback_t &&) {
+        throw std::runtime_error{"search failure"};
+    }
+};
+
+struct parallel_jst_search_test : public ::testing::TestWithParam<std::size_t> {
+    using sequence_t = std::vector<spm::dna4>;
+    using tree_t = spm::journaled_sequence_tree<spm::dna4>;
+    using variant_t = typename tree_t::variant_type;
+    using hit_t = std::tuple<std::size_t, std::ptrdiff_t, spm::coverage>;
+
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t haplotype_count = 16;
+
+    // Generates a reference with a region of high variant density to exercise the load balancing.
+    tree_t make_tree() const {
+        std::mt19937 random_engine{42};
+        auto random_symbol = [&] () { return spm::dna4{static_cast<uint8_t>(random_engine() % 4)}; };
+
+        sequence_t reference(2000);
+        std::ranges::generate(reference, random_symbol);
+        tree_t tree{reference, haplotype_count};
+        for (std::size_t index = 0; index < 400; ++index) {
+            std::size_t const position = (index < 300) ? 500 + random_engine() % 200 : random_engine() % 2000;
+            variant_t variant{.position = position, .deletion_length = 0, .insertion = {},
+                              .coverage = spm::coverage(haplotype_count)};
+            switch (random_engine() % 3) {
+                case 0: variant.deletion_length = 1; variant.insertion.push_back(random_symbol()); break;
+                case 1: variant.insertion = needle; break;
+                default: variant.deletion_length = 1 + random_engine() % 4;
+            }
+            for (std::size_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                variant.coverage.set(haplotype, random_engine() % 4 == 0);
+            tree.insert(std::move(variant));
+        }
+        return tree;
+    }
+};
+
+TEST_P(parallel_jst_search_test, equals_sequential_search) {
+    tree_t tree = make_tree();
+    spm::restorable_myers_matcher matcher{needle, 1u};
+
+    std::vector<hit_t> expected{};
+    auto sequential_matcher = matcher;
+    spm::jst_search(tree, sequential_matcher, [&] (spm::jst_hit const & hit, spm::coverage const & coverage) {
+        expected.emplace_back(hit.end_position, hit.branch_variant, coverage);
+    });
+
+    std::vector<hit_t> actual{};
+    spm::parallel_jst_search(tree, matcher, [&] (spm::jst_hit const & hit, spm::coverage const & coverage) {
+        actual.emplace_back(hit.end_position, hit.branch_variant, coverage);
+    }, GetParam());
+
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_P(parallel_jst_search_test, matcher_exception) {
+    tree_t tree = make_tree();
+    EXPECT_THROW(spm::parallel_jst_search(tree, failing_matcher{}, [] (spm::jst_hit const &, spm::coverage const &) {},
+                                          GetParam()),
+                 std::runtime_error);
+}
+
+TEST_P(parallel_jst_search_test, callback_exception) {
+    tree_t tree = make_tree();
+    spm::restorable_myers_matcher matcher{needle, 1u};
+
+    std::size_t hit_count{};
+    EXPECT_THROW(spm::parallel_jst_search(tree, matcher, [&] (spm::jst_hit const &, spm::coverage const &) {
+        if (++hit_count == 3)
+            throw std::runtime_error{"stop"};
+    }, GetParam()), std::runtime_error);
+    EXPECT_EQ(hit_count, 3u);
+}
+
+TEST_P(parallel_jst_search_test, balanced_bins) {
+    tree_t tree = make_tree();
+    std::vector<std::size_t> bins = spm::detail::balanced_bins(tree, 6, GetParam());
+
+    ASSERT_GE(bins.size(), 2u);
+    EXPECT_LE(bins.size(), GetParam() + 1);
+    EXPECT_EQ(bins.front(), 0u);
+    EXPECT_EQ(bins.back(), tree.reference().size());
+    EXPECT_TRUE(std::ranges::is_sorted(bins));
+    EXPECT_EQ(std::ranges::adjacent_find(bins), bins.end());
+
+    // The bins covering the dense region are smaller than the average bin.
+    if (bins.size() > 2) {
+        auto dense_bin = std::ranges::upper_bound(bins, 600);
+        EXPECT_LT(*dense_bin - *(dense_bin - 1), tree.reference().size() / (bins.size() - 1));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(thread_counts, parallel_jst_search_test, ::testing::Values(1u, 2u, 3u, 8u));
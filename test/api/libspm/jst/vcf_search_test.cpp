@@ -0,0 +1,128 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/jst/vcf_search.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+
+using spm::operator""_dna4;
+
+struct vcf_search_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using reader_t = spm::vcf_reader<spm::dna4>;
+    using variant_t = typename reader_t::variant_type;
+
+                                      //0         1         2         3         4
+                                      //012345678901234567890123456789012345678901234
+    sequence_t reference = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+
+    std::string vcf = "##fileformat=VCFv4.1\n"
+                      "##contig=<ID=1,length=45>\n"
+                      "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\ts0\ts1\ts2\n"
+                      "1\t9\t.\tA\tAGCA\t.\tPASS\t.\tGT\t0|1\t0|0\t0|0\n"
+                      "1\t12\t.\tA\tT,<DEL>\t.\tPASS\t.\tGT\t1|0\t1|0\t2|2\n"
+                      "1\t13\t.\tCGTG\tC\t.\tPASS\t.\tGT:DP\t0|1\t.|0\t1|0\n"
+                      "1\t14\t.\tG\tT\t.\tPASS\t.\tGT:DP\t0|0\t0|0\t0/1\n"
+                      "1\t34\t.\tCAC\tCCGCACG\t.\tPASS\t.\tGT\t1|1\t0|0\t0|1\n";
+
+    static std::vector<std::size_t> to_haplotypes(spm::coverage const & coverage) {
+        std::vector<std::size_t> haplotypes{};
+        for (std::size_t haplotype = 0; haplotype < coverage.size(); ++haplotype)
+            if (coverage.test(haplotype))
+                haplotypes.push_back(haplotype);
+        return haplotypes;
+    }
+
+    using hit_t = std::tuple<std::size_t, std::ptrdiff_t, std::vector<std::size_t>>;
+};
+
+TEST_F(vcf_search_test, concept_tests) {
+    EXPECT_TRUE(std::ranges::input_range<reader_t>);
+    EXPECT_TRUE(spm::traversable_variant<std::ranges::range_value_t<reader_t>>);
+}
+
+TEST_F(vcf_search_test, read_header) {
+    std::istringstream vcf_stream{vcf};
+    reader_t reader{vcf_stream};
+    EXPECT_EQ(reader.sample_names(), (std::vector<std::string>{"s0", "s1", "s2"}));
+    EXPECT_EQ(reader.ploidy(), 2u);
+    EXPECT_EQ(reader.haplotype_count(), 6u);
+}
+
+TEST_F(vcf_search_test, read_variants) {
+    std::istringstream vcf_stream{vcf};
+    reader_t reader{vcf_stream};
+
+    std::vector<std::tuple<std::size_t, std::size_t, sequence_t, std::vector<std::size_t>>> actual{};
+    for (variant_t const & variant : reader)
+        actual.emplace_back(variant.position, variant.deletion_length, variant.insertion, to_haplotypes(variant.coverage));
+
+    // The deletion is normalised to position 13 and hence emitted after the substitution at the same position.
+    decltype(actual) expected{{9, 0, "GCA"_dna4, {1}},
+                              {11, 1, "T"_dna4, {0, 2}},
+                              {13, 1, "T"_dna4, {5}},
+                              {13, 3, ""_dna4, {1, 4}},
+                              {34, 2, "CGCACG"_dna4, {0, 1, 5}}};
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(vcf_search_test, missing_header) {
+    std::istringstream vcf_stream{"1\t9\t.\tA\tAGCA\t.\tPASS\t.\tGT\t0|1\n"};
+    EXPECT_THROW(reader_t{vcf_stream}, std::runtime_error);
+}
+
+TEST_F(vcf_search_test, search) {
+    spm::journaled_sequence_tree<spm::dna4> tree{reference, 6};
+    std::istringstream tree_stream{vcf};
+    for (variant_t const & variant : reader_t{tree_stream})
+        tree.insert(variant);
+
+    spm::restorable_myers_matcher tree_matcher{needle, 1u};
+    std::vector<hit_t> expected{};
+    spm::jst_search(tree, tree_matcher, [&] (spm::jst_hit const & hit, spm::coverage const & coverage) {
+        expected.emplace_back(hit.end_position, hit.branch_variant, to_haplotypes(coverage));
+    });
+
+    std::istringstream vcf_stream{vcf};
+    spm::restorable_myers_matcher matcher{needle, 1u};
+    std::vector<hit_t> actual{};
+    spm::vcf_search(reference, vcf_stream, matcher, [&] (spm::jst_hit const & hit, spm::coverage const & coverage) {
+        actual.emplace_back(hit.end_position, hit.branch_variant, to_haplotypes(coverage));
+    });
+
+    EXPECT_FALSE(actual.empty());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(vcf_search_test, read_data_file) {
+    std::ifstream vcf_stream{DATADIR"sim_ref_10Kb_SNP_INDELs.vcf"};
+    ASSERT_TRUE(vcf_stream.good());
+    reader_t reader{vcf_stream};
+    EXPECT_EQ(reader.sample_names().size(), 50u);
+    EXPECT_EQ(reader.haplotype_count(), 100u);
+
+    std::size_t variant_count{};
+    std::pair<std::size_t, std::size_t> last_key{};
+    for (variant_t const & variant : reader) {
+        std::pair<std::size_t, std::size_t> key{variant.position, variant.deletion_length};
+        EXPECT_LE(last_key, key);
+        EXPECT_EQ(variant.coverage.size(), 100u);
+        last_key = key;
+        ++variant_count;
+    }
+    EXPECT_EQ(variant_count, 855u);
+}
@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/any_matcher.hpp>
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+
+using spm::operator""_dna4;
+
+struct any_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using haystack_t = std::span<spm::dna4 const>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    std::vector<std::size_t> expected_positions{13,14,15,24,25,26,35,36,37};
+    std::vector<std::size_t> expected_exact_positions{14,25,36};
+
+    template <typename matcher_t>
+    std::vector<std::size_t> search_in_chunks(matcher_t & matcher, std::size_t const chunk_size) {
+        std::vector<std::size_t> actual_positions{};
+        haystack_t const haystack_span{haystack};
+        for (std::size_t offset = 0; offset < haystack.size(); offset += chunk_size) {
+            matcher(haystack_span.subspan(offset, std::min(chunk_size, haystack.size() - offset)),
+                    offset,
+                    [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); });
+        }
+        return actual_positions;
+    }
+};
+
+TEST_F(any_matcher_test, concept_tests) {
+    EXPECT_TRUE(spm::window_matcher<spm::any_matcher<haystack_t> &>);
+    EXPECT_TRUE(spm::restorable_matcher<spm::any_restorable_matcher<haystack_t> &>);
+    EXPECT_TRUE(std::semiregular<spm::any_matcher_state>);
+}
+
+TEST_F(any_matcher_test, select_at_runtime) {
+    for (bool const approximate : {false, true}) {
+        spm::any_matcher<haystack_t> matcher = approximate
+                                             ? spm::any_matcher<haystack_t>{spm::myers_matcher{needle, errors}}
+                                             : spm::any_matcher<haystack_t>{spm::shiftor_matcher{needle}};
+
+        EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle) + (approximate ? errors : 0));
+        EXPECT_EQ(search_in_chunks(matcher, haystack.size()),
+                  approximate ? expected_positions : expected_exact_positions);
+    }
+}
+
+TEST_F(any_matcher_test, stop) {
+    spm::any_matcher<haystack_t> matcher{spm::shiftor_matcher{needle}};
+
+    std::vector<std::size_t> actual_positions{};
+    spm::search_control const control = matcher(haystack, [&] (spm::matcher_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+        return spm::search_control::stop;
+    });
+    EXPECT_EQ(control, spm::search_control::stop);
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{14}));
+}
+
+TEST_F(any_matcher_test, capture_and_restore) {
+    spm::any_restorable_matcher<haystack_t> matcher{spm::restorable_myers_matcher{needle, errors}};
+    EXPECT_EQ(search_in_chunks(matcher, 7), expected_positions);
+
+    // States are stored inline for the fixed-length matchers and on the heap for large states.
+    for (spm::any_restorable_matcher<haystack_t> fixed_length_matcher :
+            {spm::any_restorable_matcher<haystack_t>{spm::fixed_length_myers_matcher<32, spm::dna4>{needle, errors}},
+             spm::any_restorable_matcher<haystack_t>{spm::fixed_length_myers_matcher<256, spm::dna4>{needle, errors}}}) {
+        spm::any_matcher_state const initial_state = spm::capture(fixed_length_matcher);
+        std::vector<std::size_t> actual_positions{};
+        auto collect = [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); };
+
+        haystack_t const haystack_span{haystack};
+        fixed_length_matcher(haystack_span.first(20), 0, collect);
+        spm::any_matcher_state const state = spm::capture(fixed_length_matcher);
+
+        spm::restore(fixed_length_matcher, initial_state);
+        fixed_length_matcher(haystack_span.first(10), 0, [] (spm::matcher_hit const &) {});
+
+        spm::restore(fixed_length_matcher, state);
+        fixed_length_matcher(haystack_span.subspan(20), 20, collect);
+        EXPECT_EQ(actual_positions, expected_positions);
+    }
+}
+
+TEST_F(any_matcher_test, copy_and_target) {
+    using matcher_t = spm::fixed_length_shiftor_matcher<32, spm::dna4>;
+    spm::any_matcher<haystack_t> matcher{matcher_t{needle}};
+    EXPECT_NE(matcher.target<matcher_t>(), nullptr);
+    EXPECT_EQ(matcher.target<spm::fixed_length_shiftor_matcher<64, spm::dna4>>(), nullptr);
+
+    spm::any_matcher<haystack_t> copy{matcher};
+    EXPECT_NE(copy.target<matcher_t>(), matcher.target<matcher_t>());
+    EXPECT_EQ(spm::count(copy, haystack_t{haystack}), expected_exact_positions.size());
+
+    spm::any_matcher<haystack_t> moved{std::move(copy)};
+    EXPECT_FALSE(copy);
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(search_in_chunks(moved, 4), expected_exact_positions);
+}
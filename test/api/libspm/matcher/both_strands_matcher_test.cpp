@@ -0,0 +1,219 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/both_strands_matcher.hpp>
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+
+using spm::operator""_dna4;
+
+struct both_strands_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                         //0         1
+                         //0123456789012345
+    sequence_t haystack = "TTGCACGTTCGTGCAA"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+
+    static auto make_myers(std::size_t const errors) {
+        return [=] (auto && needle) {
+            return spm::restorable_myers_matcher{(decltype(needle) &&) needle, errors};
+        };
+    }
+
+    static auto make_shiftor() {
+        return [] (auto && needle) {
+            return spm::shiftor_matcher{(decltype(needle) &&) needle};
+        };
+    }
+};
+
+TEST_F(both_strands_matcher_test, reverse_complement)
+{
+    EXPECT_EQ(spm::reverse_complement(needle), "CGTGC"_dna4);
+    EXPECT_EQ(spm::reverse_complement(""_dna4), ""_dna4);
+}
+
+TEST_F(both_strands_matcher_test, concept_tests) {
+    using restorable_t = decltype(spm::make_both_strands_matcher(needle, make_myers(1)));
+    EXPECT_TRUE(spm::window_matcher<restorable_t>);
+    EXPECT_TRUE(spm::restorable_matcher<restorable_t &>);
+
+    using shiftor_t = decltype(spm::make_both_strands_matcher(needle, make_shiftor()));
+    EXPECT_TRUE(spm::window_matcher<shiftor_t>);
+    EXPECT_FALSE(spm::restorable_matcher<shiftor_t &>);
+}
+
+TEST_F(both_strands_matcher_test, temporary_needle) {
+    auto matcher = spm::make_both_strands_matcher("GCACG"_dna4, make_myers(1));
+    EXPECT_TRUE(spm::window_matcher<decltype(matcher)>);
+    EXPECT_TRUE(std::copyable<decltype(matcher)>);
+
+    // The copy refers to the needles stored by the original matcher.
+    std::optional<decltype(matcher)> original{std::move(matcher)};
+    auto copy = *original;
+    original.reset();
+
+    std::vector<spm::stranded_hit> actual_hits{};
+    copy(haystack, [&] (spm::stranded_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+
+    auto expected_matcher = spm::make_both_strands_matcher(needle, make_myers(1));
+    std::vector<spm::stranded_hit> expected_hits{};
+    expected_matcher(haystack, [&] (spm::stranded_hit const & hit) {
+        expected_hits.push_back(hit);
+    });
+    EXPECT_FALSE(expected_hits.empty());
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+TEST_F(both_strands_matcher_test, window_size) {
+    auto matcher = spm::make_both_strands_matcher(needle, make_myers(1));
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle) + 1);
+}
+
+TEST_F(both_strands_matcher_test, dna4_pattern)
+{
+    auto matcher = spm::make_both_strands_matcher(needle, make_shiftor());
+
+    std::vector<spm::stranded_hit> actual_hits{};
+    matcher(haystack, [&] (spm::stranded_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+
+    std::vector<spm::stranded_hit> expected_hits{{2, 7, spm::strand::forward}, {9, 14, spm::strand::reverse}};
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+TEST_F(both_strands_matcher_test, stop)
+{
+    auto matcher = spm::make_both_strands_matcher(needle, make_myers(0));
+
+    std::vector<spm::stranded_hit> actual_hits{};
+    spm::search_control const control = matcher(haystack, [&] (spm::stranded_hit const & hit) {
+        actual_hits.push_back(hit);
+        return spm::search_control::stop;
+    });
+    EXPECT_EQ(control, spm::search_control::stop);
+    EXPECT_EQ(actual_hits, (std::vector<spm::stranded_hit>{{2, 7, spm::strand::forward}}));
+
+    // Both strands resume after the end of the stopping hit.
+    std::size_t const resume_position = actual_hits.back().end_position;
+    matcher(std::ranges::subrange{haystack.begin() + resume_position, haystack.end()}, resume_position,
+            [&] (spm::stranded_hit const & hit) { actual_hits.push_back(hit); });
+
+    std::vector<spm::stranded_hit> expected_hits{{2, 7, spm::strand::forward}, {9, 14, spm::strand::reverse}};
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+TEST_F(both_strands_matcher_test, stop_at_shared_end_position)
+{
+    // The needle is its own reverse complement, such that both strands report every occurrence at the same position.
+    sequence_t const palindrome = "GAATTC"_dna4;
+    sequence_t const palindrome_haystack = "CGAATTCAGAATTCA"_dna4;
+    std::vector<spm::stranded_hit> expected_hits{{1, 7, spm::strand::forward}, {1, 7, spm::strand::reverse},
+                                                 {8, 14, spm::strand::forward}, {8, 14, spm::strand::reverse}};
+
+    auto matcher = spm::make_both_strands_matcher(palindrome, make_myers(0));
+    std::vector<spm::stranded_hit> actual_hits{};
+    std::size_t resume_position{};
+    while (true) {
+        auto stop_after_hit = [&] (spm::stranded_hit const & hit) {
+            actual_hits.push_back(hit);
+            resume_position = hit.end_position;
+            return spm::search_control::stop;
+        };
+
+        // The hits kept at the stop position are part of the captured state.
+        spm::restore(matcher, spm::capture(matcher));
+        std::ranges::subrange remaining{palindrome_haystack.begin() + resume_position, palindrome_haystack.end()};
+        if (matcher(remaining, resume_position, stop_after_hit) == spm::search_control::proceed)
+            break;
+    }
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+TEST_F(both_strands_matcher_test, chunked_haystack)
+{
+    std::size_t const chunk_size = decltype(spm::make_both_strands_matcher(needle, make_myers(1)))::chunk_size;
+    std::mt19937 generator{42};
+    sequence_t large_haystack(3 * chunk_size + 123);
+    for (spm::dna4 & symbol : large_haystack)
+        symbol = spm::dna4{static_cast<uint8_t>(generator() % 4)};
+
+    sequence_t const long_needle = "GCACGTTAGCCA"_dna4;
+    sequence_t const long_needle_rc = spm::reverse_complement(long_needle);
+    for (std::size_t position = 100; position + long_needle.size() < large_haystack.size(); position += 5003) {
+        sequence_t const & occurrence = ((position / 5003) % 2 == 0) ? long_needle : long_needle_rc;
+        std::ranges::copy(occurrence, large_haystack.begin() + position);
+    }
+    // An occurrence spanning the boundary of the first two chunks.
+    std::ranges::copy(long_needle, large_haystack.begin() + chunk_size - 5);
+
+    // Search both strands separately in the complete haystack.
+    auto separate_hits = [&] (std::size_t const errors) {
+        std::vector<std::tuple<std::size_t, spm::strand>> expected_hits{};
+        auto collect = [&] (sequence_t const & strand_needle, spm::strand const strand) {
+            spm::restorable_myers_matcher matcher{strand_needle, errors};
+            matcher(large_haystack, [&] (auto const & finder) {
+                expected_hits.emplace_back(seqan2::endPosition(finder), strand);
+            });
+        };
+        collect(long_needle, spm::strand::forward);
+        collect(long_needle_rc, spm::strand::reverse);
+        std::ranges::sort(expected_hits);
+        return expected_hits;
+    };
+
+    auto both_strands_hits = [&] (auto matcher) {
+        std::vector<std::tuple<std::size_t, spm::strand>> actual_hits{};
+        matcher(large_haystack, [&] (spm::stranded_hit const & hit) {
+            actual_hits.emplace_back(hit.end_position, hit.strand);
+        });
+        return actual_hits;
+    };
+
+    // The restorable matchers carry their state over and the others search the preceding window again.
+    std::vector<std::tuple<std::size_t, spm::strand>> const actual_hits =
+        both_strands_hits(spm::make_both_strands_matcher(long_needle, make_myers(1)));
+    EXPECT_GT(actual_hits.size(), 8u);
+    EXPECT_EQ(actual_hits, separate_hits(1));
+    EXPECT_EQ(both_strands_hits(spm::make_both_strands_matcher(long_needle, make_shiftor())), separate_hits(0));
+}
+
+TEST_F(both_strands_matcher_test, captured)
+{
+    auto matcher = spm::make_both_strands_matcher(needle, make_myers(0));
+    std::size_t const split = 11;
+
+    std::vector<spm::stranded_hit> actual_hits{};
+    auto collect = [&] (spm::stranded_hit const & hit) {
+        actual_hits.push_back(hit);
+    };
+    matcher(std::ranges::subrange{haystack.begin(), haystack.begin() + split}, 0, collect);
+    auto state = spm::capture(matcher);
+
+    // Search a different sequence in between and continue with the captured state.
+    matcher("GCACGGCACG"_dna4, [] (spm::stranded_hit const &) {});
+    spm::restore(matcher, state);
+    matcher(std::ranges::subrange{haystack.begin() + split, haystack.end()}, split, collect);
+
+    std::vector<spm::stranded_hit> expected_hits{{2, 7, spm::strand::forward}, {9, 14, spm::strand::reverse}};
+    EXPECT_EQ(actual_hits, expected_hits);
+}
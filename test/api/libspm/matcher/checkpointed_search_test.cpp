@@ -0,0 +1,62 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <libspm/matcher/checkpointed_search.hpp>
+
+#include "repeated_block_fixture.hpp"
+
+struct checkpointed_search_test : public repeated_block_fixture {
+    // Applies the edit to the haystack and returns it.
+    spm::haystack_edit edit(std::size_t const position, std::size_t const erased_size, sequence_t const & inserted) {
+        haystack.erase(haystack.begin() + position, haystack.begin() + position + erased_size);
+        haystack.insert(haystack.begin() + position, inserted.begin(), inserted.end());
+        return spm::haystack_edit{.position = position, .erased_size = erased_size, .inserted_size = inserted.size()};
+    }
+};
+
+TEST_F(checkpointed_search_test, search) {
+    spm::checkpointed_search search{matcher_t{needle, errors}, 100};
+    search.search(haystack);
+    EXPECT_EQ(search.hits(), full_search());
+    EXPECT_EQ(search.checkpoint_count(), haystack.size() / 100 + 1);
+}
+
+TEST_F(checkpointed_search_test, update) {
+    spm::checkpointed_search search{matcher_t{needle, errors}, 64};
+    search.search(haystack);
+
+    // Substitution creating a new hit, deletion of a hit, insertion and edits at the borders of the haystack.
+    std::vector<std::size_t> rescanned_sizes{};
+    rescanned_sizes.push_back(search.update(haystack, edit(400, 5, "GCACG"_dna4)));
+    EXPECT_EQ(search.hits(), full_search());
+    rescanned_sizes.push_back(search.update(haystack, edit(300, 30, {})));
+    EXPECT_EQ(search.hits(), full_search());
+    rescanned_sizes.push_back(search.update(haystack, edit(500, 0, "TTTTGCACGTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT"_dna4)));
+    EXPECT_EQ(search.hits(), full_search());
+    rescanned_sizes.push_back(search.update(haystack, edit(0, 3, "GCA"_dna4)));
+    EXPECT_EQ(search.hits(), full_search());
+    rescanned_sizes.push_back(search.update(haystack, edit(haystack.size() - 10, 10, "GC"_dna4)));
+    EXPECT_EQ(search.hits(), full_search());
+
+    // Only the neighbourhood of the edits is searched again.
+    for (std::size_t const rescanned_size : rescanned_sizes)
+        EXPECT_LT(rescanned_size, 200u);
+}
+
+TEST_F(checkpointed_search_test, unchanged_state) {
+    spm::checkpointed_search search{matcher_t{needle, errors}, 64};
+    search.search(haystack);
+    std::vector<spm::matcher_hit> const expected_hits = search.hits();
+
+    // Replacing a symbol by itself converges at the first checkpoint behind the edit.
+    EXPECT_LE(search.update(haystack, edit(200, 1, sequence_t{haystack[200]})), 64u);
+    EXPECT_EQ(search.hits(), expected_hits);
+}
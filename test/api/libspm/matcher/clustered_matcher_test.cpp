@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/clustered_matcher.hpp>
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+
+using spm::operator""_dna4;
+
+struct clustered_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    // The unclustered end positions are {13,14,15,24,25,26,35,36,37}.
+    std::vector<std::size_t> expected_positions{14, 25, 36};
+
+    auto get_matcher() const {
+        return spm::clustered_matcher{spm::restorable_myers_matcher{needle, errors}, errors};
+    }
+};
+
+TEST_F(clustered_matcher_test, concept_tests) {
+    using matcher_t = decltype(get_matcher());
+    EXPECT_TRUE(spm::window_matcher<matcher_t>);
+    EXPECT_TRUE(spm::restorable_matcher<matcher_t &>);
+
+    using unrestorable_matcher_t = spm::clustered_matcher<spm::myers_matcher<std::views::all_t<sequence_t &>>>;
+    EXPECT_TRUE(spm::window_matcher<unrestorable_matcher_t>);
+    EXPECT_FALSE(spm::restorable_matcher<unrestorable_matcher_t &>);
+}
+
+TEST_F(clustered_matcher_test, window_size) {
+    auto matcher = get_matcher();
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle) + errors);
+}
+
+TEST_F(clustered_matcher_test, dna4_pattern)
+{
+    auto matcher = get_matcher();
+
+    std::vector<size_t> actual_positions{};
+    matcher(haystack, [&] (spm::scored_hit const & hit) {
+        EXPECT_EQ(hit.error_count, 0u);
+        actual_positions.push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(clustered_matcher_test, stop)
+{
+    auto matcher = get_matcher();
+
+    std::vector<size_t> actual_positions{};
+    spm::search_control const control = matcher(haystack, [&] (spm::scored_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+        return spm::search_control::stop;
+    });
+    EXPECT_EQ(control, spm::search_control::stop);
+    EXPECT_EQ(actual_positions, std::vector<size_t>{14});
+
+    // The first cluster was closed by the hit ending at 24, which opened the next cluster.
+    std::size_t const resume_position = 24;
+    matcher(std::ranges::subrange{haystack.begin() + resume_position, haystack.end()}, resume_position,
+            [&] (spm::scored_hit const & hit) { actual_positions.push_back(hit.end_position); });
+    matcher.flush([&] (spm::scored_hit const & hit) { actual_positions.push_back(hit.end_position); });
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(clustered_matcher_test, dna4_pattern_captured)
+{
+    auto matcher = get_matcher();
+    std::size_t const split = 14; // splits the cluster of the first occurrence.
+
+    std::vector<size_t> actual_positions{};
+    auto collect = [&] (spm::scored_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+    };
+
+    matcher(std::ranges::subrange{haystack.begin(), haystack.begin() + split}, 0, collect);
+    EXPECT_TRUE(actual_positions.empty());
+    auto state = spm::capture(matcher);
+
+    matcher("TTTTGCACG"_dna4, [] (spm::scored_hit const &) {});
+    spm::restore(matcher, state);
+    matcher(std::ranges::subrange{haystack.begin() + split, haystack.end()}, split, collect);
+    matcher.flush(collect);
+    EXPECT_EQ(actual_positions, expected_positions);
+}
@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/compiled_myers_pattern.hpp>
+#include <libspm/matcher/compiled_shiftor_pattern.hpp>
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/contextual_matcher.hpp>
+
+using spm::operator""_dna4;
+
+struct contextual_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    std::vector<std::size_t> expected_positions{13,14,15,24,25,26,35,36,37};
+    std::vector<std::size_t> expected_exact_positions{14,25,36};
+
+    auto make_shared_pattern() const {
+        return std::make_shared<decltype(spm::compiled_myers_pattern{needle, errors}) const>(needle, errors);
+    }
+};
+
+TEST_F(contextual_matcher_test, concept_tests) {
+    using pattern_t = decltype(spm::compiled_myers_pattern{needle, errors});
+    using matcher_t = spm::contextual_matcher<pattern_t>;
+    EXPECT_TRUE(spm::compiled_pattern<pattern_t>);
+    EXPECT_TRUE(spm::window_matcher<matcher_t>);
+    EXPECT_TRUE(spm::restorable_matcher<matcher_t>);
+}
+
+TEST_F(contextual_matcher_test, window_size) {
+    spm::contextual_matcher matcher{make_shared_pattern()};
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle) + errors);
+}
+
+TEST_F(contextual_matcher_test, myers_pattern)
+{
+    spm::compiled_myers_pattern const pattern{needle, errors};
+    auto context = pattern.initial_context();
+
+    std::vector<size_t> actual_positions{};
+    pattern(haystack, context, [&] (spm::scored_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(contextual_matcher_test, shiftor_pattern)
+{
+    spm::compiled_shiftor_pattern const pattern{needle};
+    auto context = pattern.initial_context();
+
+    std::vector<size_t> actual_positions{};
+    pattern(haystack, context, [&] (spm::matcher_hit const & hit) {
+        EXPECT_EQ(hit.end_position - hit.begin_position, std::ranges::size(needle));
+        actual_positions.push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions, expected_exact_positions);
+}
+
+TEST_F(contextual_matcher_test, needle_exceeds_word)
+{
+    sequence_t const long_needle(65, spm::dna4{'A'});
+    EXPECT_THROW((spm::compiled_myers_pattern{long_needle, errors}), std::invalid_argument);
+    EXPECT_THROW((spm::compiled_shiftor_pattern{long_needle}), std::invalid_argument);
+
+    spm::compiled_shiftor_pattern pattern{needle};
+    EXPECT_THROW(pattern.set_needle(long_needle), std::invalid_argument);
+}
+
+TEST_F(contextual_matcher_test, captured)
+{
+    spm::contextual_matcher matcher{spm::compiled_myers_pattern{needle, errors}};
+    std::size_t const split = 14;
+
+    std::vector<size_t> actual_positions{};
+    auto collect = [&] (spm::scored_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+    };
+
+    matcher(std::span{haystack}.first(split), 0, collect);
+    auto state = spm::capture(matcher);
+
+    matcher("TTTTGCACG"_dna4, [] (spm::scored_hit const &) {});
+    spm::restore(matcher, state);
+
+    matcher(std::span{haystack}.subspan(split), split, collect);
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(contextual_matcher_test, shared_between_threads)
+{
+    std::size_t const thread_count = 4;
+    auto const pattern = make_shared_pattern();
+
+    std::vector<std::vector<std::size_t>> actual_positions(thread_count);
+    {
+        std::vector<std::jthread> threads{};
+        for (std::size_t thread_id = 0; thread_id < thread_count; ++thread_id) {
+            threads.emplace_back([&, thread_id] () {
+                spm::contextual_matcher matcher{pattern};
+                matcher(haystack, [&] (spm::scored_hit const & hit) {
+                    actual_positions[thread_id].push_back(hit.end_position);
+                });
+            });
+        }
+    }
+
+    for (std::vector<std::size_t> const & positions : actual_positions)
+        EXPECT_EQ(positions, expected_positions);
+    EXPECT_EQ(pattern.use_count(), 1); // the matchers of the threads shared the pattern without copying it.
+}
@@ -0,0 +1,160 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/stratified_search.hpp>
+
+using spm::operator""_dna4;
+
+struct fixed_length_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    std::vector<std::size_t> expected_positions{13,14,15,24,25,26,35,36,37};
+    std::vector<std::size_t> expected_exact_positions{14,25,36};
+};
+
+TEST_F(fixed_length_matcher_test, concept_tests) {
+    using myers_t = spm::fixed_length_myers_matcher<32, spm::dna4>;
+    using shiftor_t = spm::fixed_length_shiftor_matcher<128, spm::dna4>;
+    EXPECT_TRUE(spm::restorable_matcher<myers_t>);
+    EXPECT_TRUE(spm::scored_matcher<myers_t>);
+    EXPECT_TRUE(spm::restorable_matcher<shiftor_t>);
+    EXPECT_TRUE(std::is_trivially_copyable_v<spm::matcher_state_t<myers_t>>);
+    EXPECT_TRUE(std::is_trivially_copyable_v<spm::matcher_state_t<shiftor_t>>);
+}
+
+TEST_F(fixed_length_matcher_test, myers) {
+    spm::fixed_length_myers_matcher<32, spm::dna4> matcher{needle, errors};
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle) + errors);
+
+    std::vector<std::size_t> actual_positions{};
+    matcher(haystack, [&] (spm::matcher_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+        EXPECT_LE(matcher.error_count(), errors);
+    });
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(fixed_length_matcher_test, shiftor) {
+    spm::fixed_length_shiftor_matcher<32, spm::dna4> matcher{needle};
+
+    std::vector<std::size_t> actual_positions{};
+    matcher(haystack, [&] (spm::matcher_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+        EXPECT_EQ(hit.end_position - hit.begin_position, std::ranges::size(needle));
+    });
+    EXPECT_EQ(actual_positions, expected_exact_positions);
+}
+
+TEST_F(fixed_length_matcher_test, multi_word_needle) {
+    // The needle spans two 64-bit words, such that the carries between the words are exercised.
+    sequence_t long_needle{};
+    for (std::size_t i = 0; i < 7; ++i)
+        long_needle.insert(long_needle.end(), haystack.begin() + 1, haystack.begin() + 12);
+
+    sequence_t long_haystack{};
+    for (std::size_t i = 0; i < 8; ++i)
+        long_haystack.insert(long_haystack.end(), haystack.begin() + 1, haystack.begin() + 12);
+
+    spm::fixed_length_shiftor_matcher<128, spm::dna4> shiftor{long_needle};
+    std::vector<std::size_t> actual_positions{};
+    shiftor(long_haystack, [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{77, 88}));
+
+    spm::fixed_length_myers_matcher<128, spm::dna4> myers{long_needle, 0};
+    actual_positions.clear();
+    myers(long_haystack, [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{77, 88}));
+}
+
+TEST_F(fixed_length_matcher_test, capture_and_restore) {
+    spm::fixed_length_myers_matcher<64, spm::dna4> matcher{needle, errors};
+    auto const initial_state = matcher.capture();
+
+    std::vector<std::size_t> actual_positions{};
+    auto collect = [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); };
+    std::span const haystack_span{haystack};
+    matcher(haystack_span.first(20), 0, collect);
+    auto const state = matcher.capture();
+
+    matcher.restore(initial_state);
+    matcher(haystack_span.first(10), 0, [] (spm::matcher_hit const &) {});
+
+    matcher.restore(state);
+    matcher(haystack_span.subspan(20), 20, collect);
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(fixed_length_matcher_test, rebind) {
+    spm::fixed_length_myers_matcher<32, spm::dna4> matcher{"TGACTAGC"_dna4, 0};
+
+    std::vector<std::size_t> actual_positions{};
+    auto collect = [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); };
+    matcher(haystack, collect);
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{11, 22, 33, 44}));
+
+    actual_positions.clear();
+    matcher.set_needle(needle);
+    matcher(haystack, collect);
+    EXPECT_EQ(actual_positions, expected_exact_positions);
+
+    actual_positions.clear();
+    matcher.rebind(needle, errors);
+    matcher(haystack, collect);
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(fixed_length_matcher_test, needle_exceeds_bound) {
+    using myers_t = spm::fixed_length_myers_matcher<8, spm::dna4>;
+    using shiftor_t = spm::fixed_length_shiftor_matcher<8, spm::dna4>;
+
+    EXPECT_THROW((myers_t{haystack, errors}), std::invalid_argument);
+    EXPECT_THROW((shiftor_t{haystack}), std::invalid_argument);
+
+    myers_t myers_matcher{needle, errors};
+    EXPECT_THROW(myers_matcher.set_needle(haystack), std::invalid_argument);
+    shiftor_t shiftor_matcher{needle};
+    EXPECT_THROW(shiftor_matcher.set_needle(haystack), std::invalid_argument);
+}
+
+TEST_F(fixed_length_matcher_test, visit_smallest_bucket) {
+    std::vector<std::size_t> actual_positions{};
+    bool const visited = spm::visit_fixed_length_matcher<spm::fixed_length_myers_matcher>([&] (auto & matcher) {
+        EXPECT_TRUE((std::same_as<std::remove_cvref_t<decltype(matcher)>,
+                                  spm::fixed_length_myers_matcher<32, spm::dna4>>));
+        matcher(haystack, [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); });
+    }, needle, errors);
+
+    EXPECT_TRUE(visited);
+    EXPECT_EQ(actual_positions, expected_positions);
+
+    sequence_t const long_needle(100, 'A'_dna4);
+    EXPECT_TRUE(spm::visit_fixed_length_matcher<spm::fixed_length_shiftor_matcher>([] (auto & matcher) {
+        EXPECT_TRUE((std::same_as<std::remove_cvref_t<decltype(matcher)>,
+                                  spm::fixed_length_shiftor_matcher<128, spm::dna4>>));
+    }, long_needle));
+
+    sequence_t const too_long_needle(257, 'A'_dna4);
+    EXPECT_FALSE(spm::visit_fixed_length_matcher<spm::fixed_length_shiftor_matcher>([] (auto &) {
+        FAIL() << "No matcher must be constructed for needles exceeding the largest bucket.";
+    }, too_long_needle));
+}
@@ -0,0 +1,140 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/hit_buffer.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/stratified_search.hpp>
+
+using spm::operator""_dna4;
+
+struct hit_buffer_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    std::vector<std::size_t> expected_positions{13,14,15,24,25,26,35,36,37};
+};
+
+TEST_F(hit_buffer_test, sink)
+{
+    spm::restorable_myers_matcher matcher{needle, errors};
+    spm::hit_buffer buffer{};
+    spm::scored_search(matcher, haystack, 0, buffer.sink(3));
+
+    EXPECT_EQ(buffer.size(), expected_positions.size());
+    EXPECT_TRUE(std::ranges::equal(buffer.end_positions(), expected_positions));
+    EXPECT_TRUE(std::ranges::all_of(buffer.needle_ids(), [] (std::size_t const id) { return id == 3; }));
+    EXPECT_TRUE(std::ranges::all_of(buffer.haystack_ids(), [] (std::size_t const id) { return id == 0; }));
+    EXPECT_EQ(buffer.scores()[0], -1);
+    EXPECT_EQ(buffer.scores()[1], 0);
+    EXPECT_EQ(buffer[1], (spm::hit_record{.needle_id = 3,
+                                          .haystack_id = 0,
+                                          .begin_position = 8,
+                                          .end_position = 14,
+                                          .score = 0}));
+}
+
+TEST_F(hit_buffer_test, sort_and_unique)
+{
+    spm::hit_buffer buffer{};
+    auto sink = buffer.sink(1, 2);
+    sink(spm::matcher_hit{.begin_position = 4, .end_position = 9});
+    sink(spm::matcher_hit{.begin_position = 0, .end_position = 5});
+    sink(spm::matcher_hit{.begin_position = 4, .end_position = 9});
+    buffer.push_back(spm::hit_record{.needle_id = 0, .haystack_id = 2, .begin_position = 4, .end_position = 9});
+
+    buffer.sort();
+    EXPECT_EQ(buffer.end_positions()[0], 5u);
+    EXPECT_EQ(buffer.needle_ids()[1], 0u);
+
+    buffer.unique();
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_TRUE(std::ranges::equal(buffer.needle_ids(), std::vector<std::size_t>{1, 0, 1}));
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(hit_buffer_test, merge)
+{
+    spm::hit_buffer buffers[3]{};
+    auto first = buffers[0].sink(0);
+    first(spm::matcher_hit{.begin_position = 0, .end_position = 5});
+    first(spm::matcher_hit{.begin_position = 10, .end_position = 15});
+    auto second = buffers[1].sink(1);
+    second(spm::matcher_hit{.begin_position = 2, .end_position = 7});
+    second(spm::matcher_hit{.begin_position = 5, .end_position = 15});
+
+    spm::hit_buffer merged = spm::merge_hit_buffers(buffers);
+    EXPECT_TRUE(std::ranges::equal(merged.end_positions(), std::vector<std::size_t>{5, 7, 15, 15}));
+    EXPECT_TRUE(std::ranges::equal(merged.begin_positions(), std::vector<std::size_t>{0, 2, 5, 10}));
+    EXPECT_TRUE(std::ranges::equal(merged.needle_ids(), std::vector<std::size_t>{0, 1, 1, 0}));
+}
+
+TEST_F(hit_buffer_test, per_thread_blocks)
+{
+    std::size_t const thread_count = 4;
+    std::mutex buffer_mutex{};
+    std::vector<spm::hit_buffer> thread_buffers(thread_count);
+    std::size_t block_count{};
+
+    auto search = [&] (std::size_t const thread_id) {
+        spm::hit_block_writer writer{2, [&] (spm::hit_buffer const & block) {
+            std::scoped_lock lock{buffer_mutex};
+            thread_buffers[thread_id].append(block);
+            ++block_count;
+        }};
+        spm::restorable_myers_matcher matcher{needle, errors};
+        matcher(haystack, 0, writer.sink(thread_id));
+        writer.flush();
+    };
+
+    {
+        std::vector<std::jthread> threads{};
+        for (std::size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+            threads.emplace_back(search, thread_id);
+    }
+
+    EXPECT_EQ(block_count, thread_count * 5);
+    for (spm::hit_buffer & buffer : thread_buffers)
+        buffer.sort();
+
+    spm::hit_buffer merged = spm::merge_hit_buffers(thread_buffers);
+    ASSERT_EQ(merged.size(), thread_count * expected_positions.size());
+    for (std::size_t index = 0; index < merged.size(); ++index) {
+        EXPECT_EQ(merged.end_positions()[index], expected_positions[index / thread_count]);
+        EXPECT_EQ(merged.needle_ids()[index], index % thread_count);
+    }
+}
+
+TEST_F(hit_buffer_test, block_writer_flushes_on_destruction)
+{
+    spm::hit_buffer buffer{};
+    {
+        spm::hit_block_writer writer{4, [&] (spm::hit_buffer const & block) { buffer.append(block); }};
+        spm::restorable_myers_matcher matcher{needle, errors};
+        matcher(haystack, 0, writer.sink(0));
+        EXPECT_LT(buffer.size(), expected_positions.size());
+    }
+    ASSERT_EQ(buffer.size(), expected_positions.size());
+    EXPECT_TRUE(std::ranges::equal(buffer.end_positions(), expected_positions));
+
+    EXPECT_FALSE(std::is_move_constructible_v<spm::hit_block_writer<void (*)(spm::hit_buffer const &)>>);
+}
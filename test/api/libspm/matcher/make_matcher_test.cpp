@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/make_matcher.hpp>
+#include <libspm/matcher/matcher_cost_model.hpp>
+
+using spm::operator""_dna4;
+
+template <typename needle_t>
+concept makes_matcher = requires (needle_t && needle) {
+    spm::make_matcher<std::span<spm::dna4 const>>((needle_t &&) needle);
+};
+
+struct make_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using haystack_t = std::span<spm::dna4 const>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    std::vector<std::size_t> expected_positions{13,14,15,24,25,26,35,36,37};
+    std::vector<std::size_t> expected_exact_positions{14,25,36};
+
+    // A model in which only the given engine is cheap.
+    static spm::matcher_cost_model favour(spm::matcher_engine const favoured_engine) {
+        spm::matcher_cost_model model{};
+        for (std::size_t index = 0; index < spm::matcher_engine_count; ++index) {
+            spm::matcher_engine const engine{index};
+            model[engine] = spm::matcher_cost{.fixed_cost = (engine == favoured_engine) ? 1.0 : 10.0, .load_cost = 0.0};
+        }
+        return model;
+    }
+};
+
+TEST_F(make_matcher_test, select) {
+    spm::matcher_cost_model const model = favour(spm::matcher_engine::horspool);
+    EXPECT_EQ(model.select(5, 0, false), spm::matcher_engine::horspool);
+    EXPECT_TRUE(spm::is_approximate(model.select(5, 1, false)));
+    EXPECT_TRUE(spm::is_restorable(model.select(5, 0, true)));
+
+    // The fixed-length engines are not applicable to needles exceeding the largest bucket.
+    spm::matcher_cost_model const fixed_length_model = favour(spm::matcher_engine::fixed_length_myers);
+    EXPECT_EQ(fixed_length_model.select(256, 3, false), spm::matcher_engine::fixed_length_myers);
+    EXPECT_NE(fixed_length_model.select(257, 3, false), spm::matcher_engine::fixed_length_myers);
+}
+
+TEST_F(make_matcher_test, load) {
+    spm::matcher_cost_model model{};
+    model[spm::matcher_engine::myers] = spm::matcher_cost{.fixed_cost = 1.0, .load_cost = 2.0};
+    EXPECT_DOUBLE_EQ(model.estimate(spm::matcher_engine::myers, 64), 3.0);
+    EXPECT_DOUBLE_EQ(model.estimate(spm::matcher_engine::myers, 65), 5.0);
+    EXPECT_DOUBLE_EQ(spm::matcher_engine_load(spm::matcher_engine::fixed_length_myers, 33), 1.0);
+    EXPECT_DOUBLE_EQ(spm::matcher_engine_load(spm::matcher_engine::horspool, 4), 0.25);
+    EXPECT_EQ(spm::matcher_engine_load(spm::matcher_engine::fixed_length_shiftor, 257),
+              std::numeric_limits<double>::infinity());
+}
+
+TEST_F(make_matcher_test, profile) {
+    spm::matcher_cost_model model{};
+    model[spm::matcher_engine::restorable_myers] = spm::matcher_cost{.fixed_cost = 0.123456789, .load_cost = 4.5};
+
+    std::stringstream profile{};
+    model.write_profile(profile);
+    EXPECT_EQ(spm::matcher_cost_model::read_profile(profile), model);
+
+    std::istringstream unknown_engine{"# comment\nboyer_moore 1.0 2.0\n"};
+    EXPECT_THROW(spm::matcher_cost_model::read_profile(unknown_engine), std::runtime_error);
+
+    std::istringstream malformed_line{"myers 1.0\n"};
+    EXPECT_THROW(spm::matcher_cost_model::read_profile(malformed_line), std::runtime_error);
+}
+
+TEST_F(make_matcher_test, every_engine) {
+    for (std::size_t index = 0; index < spm::matcher_engine_count; ++index) {
+        spm::matcher_engine const engine{index};
+        spm::matcher_cost_model const model = favour(engine);
+        std::size_t const error_count = spm::is_approximate(engine) ? errors : 0;
+
+        spm::any_matcher<haystack_t> matcher = spm::make_matcher<haystack_t>(needle,
+                                                                             error_count,
+                                                                             {.cost_model = &model});
+        std::vector<std::size_t> actual_positions{};
+        matcher(haystack, [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); });
+        EXPECT_EQ(actual_positions, spm::is_approximate(engine) ? expected_positions : expected_exact_positions)
+            << spm::matcher_engine_name(engine);
+    }
+}
+
+TEST_F(make_matcher_test, borrowed_needle) {
+    // The erased matcher refers to the needle, which a temporary would not outlive.
+    EXPECT_TRUE(makes_matcher<sequence_t &>);
+    EXPECT_TRUE(makes_matcher<sequence_t const &>);
+    EXPECT_TRUE(makes_matcher<std::span<spm::dna4 const>>);
+    EXPECT_FALSE(makes_matcher<sequence_t>);
+}
+
+TEST_F(make_matcher_test, inapplicable_engine) {
+    using restorable_t = spm::any_restorable_matcher<haystack_t>;
+    EXPECT_THROW(spm::detail::make_engine<restorable_t>(spm::matcher_engine::horspool, needle, 0),
+                 std::invalid_argument);
+
+    sequence_t const long_needle(257, spm::dna4{});
+    EXPECT_THROW(spm::detail::make_engine<restorable_t>(spm::matcher_engine::fixed_length_myers, long_needle, errors),
+                 std::invalid_argument);
+}
+
+TEST_F(make_matcher_test, restorable) {
+    spm::any_restorable_matcher<haystack_t> matcher = spm::make_restorable_matcher<haystack_t>(needle, errors);
+
+    std::vector<std::size_t> actual_positions{};
+    auto collect = [&] (spm::matcher_hit const & hit) { actual_positions.push_back(hit.end_position); };
+    haystack_t const haystack_span{haystack};
+    matcher(haystack_span.first(20), 0, collect);
+    spm::any_matcher_state const state = spm::capture(matcher);
+    matcher(haystack_span.first(10), 0, [] (spm::matcher_hit const &) {});
+    spm::restore(matcher, state);
+    matcher(haystack_span.subspan(20), 20, collect);
+    EXPECT_EQ(actual_positions, expected_positions);
+}
+
+TEST_F(make_matcher_test, calibrate) {
+    spm::matcher_cost_model const model = spm::calibrate_matcher_cost_model<spm::dna4>(1 << 12);
+    for (std::size_t index = 0; index < spm::matcher_engine_count; ++index) {
+        EXPECT_GE(model[spm::matcher_engine{index}].fixed_cost, 0.0);
+        EXPECT_GE(model[spm::matcher_engine{index}].load_cost, 0.0);
+    }
+
+    spm::any_matcher<haystack_t> matcher = spm::make_matcher<haystack_t>(needle, errors, {.cost_model = &model});
+    EXPECT_EQ(spm::count(matcher, haystack_t{haystack}), expected_positions.size());
+}
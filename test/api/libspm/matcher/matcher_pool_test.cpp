@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/matcher_pool.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+
+using spm::operator""_dna4;
+
+struct matcher_pool_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using needle_t = std::views::all_t<sequence_t const &>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    std::vector<sequence_t> reads{"GCACG"_dna4, "TGACTAGC"_dna4, "GCACG"_dna4};
+    std::size_t errors = 1;
+
+    std::vector<std::vector<std::size_t>> expected_positions{{13,14,15,24,25,26,35,36,37},
+                                                             {10,11,12,21,22,23,32,33,34,43,44},
+                                                             {13,14,15,24,25,26,35,36,37}};
+
+    template <typename matcher_t>
+    std::vector<std::size_t> search(matcher_t & matcher) const {
+        std::vector<std::size_t> positions{};
+        matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { positions.push_back(hit.end_position); });
+        return positions;
+    }
+};
+
+TEST_F(matcher_pool_test, concept_tests)
+{
+    using myers_t = spm::restorable_myers_matcher<needle_t>;
+    EXPECT_TRUE((spm::rebindable_matcher<myers_t, sequence_t const &, std::size_t>));
+    EXPECT_TRUE((spm::rebindable_matcher<myers_t, sequence_t const &>));
+    EXPECT_TRUE((spm::rebindable_matcher<spm::shiftor_matcher<needle_t>, sequence_t const &>));
+    EXPECT_FALSE((spm::rebindable_matcher<spm::shiftor_matcher<needle_t>, sequence_t const &, std::size_t>));
+}
+
+TEST_F(matcher_pool_test, reuse_released_matcher)
+{
+    spm::matcher_pool<spm::restorable_myers_matcher<needle_t>> pool{};
+    for (std::size_t read = 0; read < reads.size(); ++read) {
+        auto matcher = pool.acquire(reads[read], errors);
+        EXPECT_EQ(search(*matcher), expected_positions[read]);
+    }
+    EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST_F(matcher_pool_test, concurrent_leases)
+{
+    spm::matcher_pool<spm::restorable_myers_matcher<needle_t>> pool{};
+    {
+        auto first = pool.acquire(reads[0], errors);
+        auto second = pool.acquire(reads[1], errors);
+        EXPECT_EQ(pool.size(), 2u);
+        EXPECT_EQ(search(*first), expected_positions[0]);
+        EXPECT_EQ(search(*second), expected_positions[1]);
+    }
+
+    auto matcher = pool.acquire(reads[2], errors);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(spm::window_size(*matcher), std::ranges::size(reads[2]) + errors);
+    EXPECT_EQ(search(*matcher), expected_positions[2]);
+}
@@ -8,11 +8,17 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
 
 #include <libspm/seqan/alphabet.hpp>
 
 #include <libspm/matcher/concept.hpp>
 #include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/search_control.hpp>
 
 using spm::operator""_dna4;
 
@@ -72,3 +78,143 @@ TEST_F(myers_matcher_restorable_test, dna4_pattern_captured)
     }
     EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
 }
+
+TEST_F(myers_matcher_restorable_test, dna4_pattern_subrange)
+{
+    std::size_t chunk_size{13};
+
+    auto matcher = get_matcher();
+    std::vector<size_t> actual_positions{};
+    for (std::size_t offset = 0; offset < haystack.size(); offset += chunk_size) {
+        std::span chunk{haystack.data() + offset, std::min(chunk_size, haystack.size() - offset)};
+        matcher(chunk, offset, [&] (spm::matcher_hit const & hit) {
+            EXPECT_EQ(hit.begin_position, hit.end_position - spm::window_size(matcher));
+            actual_positions.push_back(hit.end_position);
+        });
+    }
+    EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
+}
+
+TEST_F(myers_matcher_restorable_test, dna4_pattern_segmented)
+{
+    // The segments split occurrences of the needle and contain an empty segment.
+    std::vector<std::span<spm::dna4 const>> segments{std::span{haystack.data(), 11},
+                                                     std::span{haystack.data() + 11, 2},
+                                                     std::span{haystack.data() + 13, 0},
+                                                     std::span{haystack.data() + 13, 20},
+                                                     std::span{haystack.data() + 33, haystack.size() - 33}};
+    EXPECT_TRUE(spm::segmented_haystack<decltype(segments)>);
+
+    auto matcher = get_matcher();
+    std::vector<size_t> actual_positions{};
+    matcher(segments, [&] (spm::matcher_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+    });
+    EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
+}
+
+TEST_F(myers_matcher_restorable_test, dna4_pattern_stopped_and_resumed)
+{
+    auto matcher = get_matcher();
+
+    // Stop after every fourth hit and resume behind the last reported hit.
+    std::vector<size_t> actual_positions{};
+    std::size_t resume_position{};
+    std::size_t stop_count{};
+    while (true) {
+        spm::hit_budget budget{4, [&] (spm::matcher_hit const & hit) {
+            actual_positions.push_back(hit.end_position);
+            resume_position = hit.end_position;
+        }};
+        std::span remaining{haystack.data() + resume_position, haystack.size() - resume_position};
+        if (matcher(remaining, resume_position, budget) == spm::search_control::proceed)
+            break;
+        EXPECT_TRUE(budget.exhausted());
+        ++stop_count;
+    }
+    EXPECT_EQ(stop_count, 2u);
+    EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
+
+    EXPECT_THROW((spm::hit_budget{0, [] (spm::matcher_hit const &) {}}), std::invalid_argument);
+}
+
+TEST_F(myers_matcher_restorable_test, dna4_pattern_stop_signal)
+{
+    auto matcher = get_matcher();
+
+    std::vector<size_t> actual_positions{};
+    spm::search_control const control = matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::endPosition(finder));
+        return (actual_positions.size() == 2) ? spm::search_control::stop : spm::search_control::proceed;
+    });
+    EXPECT_EQ(control, spm::search_control::stop);
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{13, 14}));
+
+    std::stop_source stop_source{};
+    actual_positions.clear();
+    matcher = get_matcher();
+    matcher(haystack, spm::stop_when_requested(stop_source.get_token(), [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::endPosition(finder));
+        if (actual_positions.size() == 3)
+            stop_source.request_stop();
+    }));
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{13, 14, 15}));
+}
+
+TEST_F(myers_matcher_restorable_test, dna4_pattern_pulled)
+{
+    auto matcher = get_matcher();
+    auto hits = spm::search(matcher, haystack);
+    EXPECT_TRUE(std::ranges::input_range<decltype(hits)>);
+
+    std::vector<size_t> actual_positions{};
+    for (spm::matcher_hit const & hit : hits)
+        actual_positions.push_back(hit.end_position);
+    EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
+
+    matcher = get_matcher();
+    auto end_positions = spm::search(matcher, haystack)
+                       | std::views::transform([] (spm::matcher_hit const & hit) { return hit.end_position; })
+                       | std::views::take(4);
+    actual_positions.clear();
+    std::ranges::copy(end_positions, std::back_inserter(actual_positions));
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{13, 14, 15, 24}));
+}
+
+TEST_F(myers_matcher_restorable_test, dna4_pattern_pulled_empty)
+{
+    auto matcher = get_matcher();
+    using hit_range_t = decltype(spm::search(matcher, haystack));
+
+    hit_range_t empty_hits{};
+    EXPECT_TRUE(empty_hits.begin() == empty_hits.end());
+
+    hit_range_t hits = spm::search(matcher, haystack);
+    hit_range_t moved_hits = std::move(hits);
+    EXPECT_TRUE(hits.begin() == hits.end());
+    EXPECT_EQ((*moved_hits.begin()).end_position, expected_positions.front());
+}
+
+TEST_F(myers_matcher_restorable_test, rebind)
+{
+    auto matcher = get_matcher();
+    sequence_t const other_needle = "TGACTAGC"_dna4;
+    auto collect_positions = [&] () {
+        std::vector<size_t> actual_positions{};
+        matcher(haystack, [&] (auto const & finder) {
+            actual_positions.push_back(seqan2::endPosition(finder));
+        });
+        return actual_positions;
+    };
+
+    matcher.rebind(other_needle, 0u);
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(other_needle));
+    EXPECT_EQ(collect_positions(), (std::vector<std::size_t>{11, 22, 33, 44}));
+
+    matcher.set_needle(needle);
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle));
+    EXPECT_EQ(collect_positions(), (std::vector<std::size_t>{14, 25, 36}));
+
+    matcher.rebind(needle, errors);
+    EXPECT_EQ(collect_positions(), expected_positions);
+}
@@ -0,0 +1,247 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/myers_matcher_simd.hpp>
+
+using spm::operator""_dna4;
+
+struct myers_matcher_simd_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                                           //0         1         2         3         4
+                                           //012345678901234567890123456789012345678901234
+    std::vector<sequence_t> haystacks{"ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4,
+                                      "ACGTGACTAGCACCTGACTAGCACGTGACTAGCACGTGA"_dna4,
+                                      "TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT"_dna4,
+                                      "GCACGGCACG"_dna4,
+                                      ""_dna4};
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    auto get_matcher() const noexcept {
+        return spm::simd_myers_matcher{needle, errors};
+    }
+
+    std::vector<std::vector<std::size_t>> expected_positions() const {
+        std::vector<std::vector<std::size_t>> expected{};
+        for (auto const & haystack : haystacks) {
+            spm::restorable_myers_matcher matcher{needle, errors};
+            std::vector<std::size_t> positions{};
+            if (!haystack.empty())
+                matcher(haystack, [&] (auto const & finder) {
+                    positions.push_back(seqan2::endPosition(finder));
+                });
+            expected.push_back(std::move(positions));
+        }
+        return expected;
+    }
+};
+
+TEST_F(myers_matcher_simd_test, concept_tests) {
+    using matcher_t = decltype(get_matcher());
+    EXPECT_TRUE(spm::window_matcher<matcher_t>);
+    EXPECT_TRUE(spm::restorable_matcher<matcher_t>);
+}
+
+TEST_F(myers_matcher_simd_test, window_size) {
+    auto matcher = get_matcher();
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle) + errors);
+}
+
+TEST_F(myers_matcher_simd_test, deduce_without_error_count) {
+    spm::simd_myers_matcher matcher{needle};
+    EXPECT_TRUE((std::same_as<decltype(matcher), spm::simd_myers_matcher<std::ranges::ref_view<sequence_t>>>));
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(needle));
+
+    std::vector<std::vector<std::size_t>> actual_positions(haystacks.size());
+    matcher(haystacks, [&] (spm::multi_haystack_hit const & hit) {
+        EXPECT_EQ(hit.error_count, 0u);
+        actual_positions[hit.haystack_id].push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::vector<std::size_t>>{{14, 25, 36}, {25, 36}, {}, {5, 10}, {}}));
+}
+
+TEST_F(myers_matcher_simd_test, needle_exceeds_word) {
+    sequence_t const long_needle(65, spm::dna4{'A'});
+    EXPECT_THROW((spm::simd_myers_matcher{long_needle, errors}), std::invalid_argument);
+
+    auto matcher = get_matcher();
+    EXPECT_THROW(matcher.set_needle(long_needle), std::invalid_argument);
+}
+
+TEST_F(myers_matcher_simd_test, dna4_pattern)
+{
+    auto matcher = get_matcher();
+
+    std::vector<std::vector<std::size_t>> actual_positions(haystacks.size());
+    matcher(haystacks, [&] (spm::multi_haystack_hit const & hit) {
+        EXPECT_LE(hit.error_count, errors);
+        actual_positions[hit.haystack_id].push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions[0], (std::vector<std::size_t>{13,14,15,24,25,26,35,36,37}));
+    EXPECT_EQ(actual_positions, expected_positions());
+}
+
+TEST_F(myers_matcher_simd_test, haystacks_exceeding_block)
+{
+    // Haystacks spanning several transposed blocks with lengths that end inside and at the border of a block.
+    haystacks.clear();
+    for (std::size_t const repeat : {0u, 3u, 4u, 11u, 16u, 29u}) {
+        sequence_t haystack{};
+        for (std::size_t index = 0; index < repeat; ++index)
+            std::ranges::copy("ACGTGACTAGCACGTG"_dna4, std::back_inserter(haystack));
+        haystacks.push_back(std::move(haystack));
+    }
+
+    auto matcher = get_matcher();
+    std::vector<std::vector<std::size_t>> actual_positions(haystacks.size());
+    matcher(haystacks, [&] (spm::multi_haystack_hit const & hit) {
+        actual_positions[hit.haystack_id].push_back(hit.end_position);
+    });
+    EXPECT_EQ(actual_positions, expected_positions());
+}
+
+TEST_F(myers_matcher_simd_test, stop)
+{
+    std::vector<spm::multi_haystack_hit> all_hits{};
+    get_matcher()(haystacks, [&] (spm::multi_haystack_hit const & hit) { all_hits.push_back(hit); });
+    ASSERT_GT(all_hits.size(), 3u);
+
+    auto matcher = get_matcher();
+    std::vector<spm::multi_haystack_hit> actual_hits{};
+    spm::search_control const control = matcher(haystacks, [&] (spm::multi_haystack_hit const & hit) {
+        actual_hits.push_back(hit);
+        return (actual_hits.size() == 3) ? spm::search_control::stop : spm::search_control::proceed;
+    });
+    EXPECT_EQ(control, spm::search_control::stop);
+    EXPECT_EQ(actual_hits, (std::vector<spm::multi_haystack_hit>{all_hits.begin(), all_hits.begin() + 3}));
+}
+
+TEST_F(myers_matcher_simd_test, stopped_and_resumed)
+{
+    auto matcher = get_matcher();
+
+    // Stop after every second hit, which splits the hits of the first two haystacks ending at the same position.
+    std::vector<std::vector<std::size_t>> actual_positions(haystacks.size());
+    std::vector<std::size_t> resume_positions(haystacks.size());
+    while (true) {
+        std::vector<std::span<spm::dna4 const>> remaining{};
+        for (std::size_t lane = 0; lane < haystacks.size(); ++lane)
+            remaining.emplace_back(haystacks[lane].data() + resume_positions[lane],
+                                   haystacks[lane].size() - resume_positions[lane]);
+
+        std::size_t hit_count{};
+        spm::multi_haystack_hit stop_hit{};
+        spm::search_control const control = matcher(remaining, [&] (spm::multi_haystack_hit const & hit) {
+            actual_positions[hit.haystack_id].push_back(resume_positions[hit.haystack_id] + hit.end_position);
+            stop_hit = hit;
+            return (++hit_count == 2) ? spm::search_control::stop : spm::search_control::proceed;
+        });
+        if (control == spm::search_control::proceed)
+            break;
+
+        // The lanes up to the stopping lane continue at the stop position and the following lanes one before it.
+        for (std::size_t lane = 0; lane < haystacks.size(); ++lane) {
+            std::size_t const searched = stop_hit.end_position - ((lane <= stop_hit.haystack_id) ? 0 : 1);
+            resume_positions[lane] += std::min(searched, remaining[lane].size());
+        }
+    }
+    EXPECT_EQ(actual_positions, expected_positions());
+}
+
+TEST_F(myers_matcher_simd_test, dna4_pattern_captured)
+{
+    std::size_t chunk_size{7};
+    std::size_t max_size = std::ranges::max(haystacks | std::views::transform(std::ranges::size));
+
+    auto matcher = get_matcher();
+    auto state = matcher.capture();
+    std::vector<std::vector<std::size_t>> actual_positions(haystacks.size());
+    for (std::size_t offset = 0; offset < max_size; offset += chunk_size) {
+        std::vector<std::span<spm::dna4 const>> chunks{};
+        for (auto const & haystack : haystacks) {
+            std::size_t const chunk_begin = std::min(offset, haystack.size());
+            std::size_t const chunk_end = std::min(offset + chunk_size, haystack.size());
+            chunks.emplace_back(haystack.data() + chunk_begin, chunk_end - chunk_begin);
+        }
+        matcher.restore(state);
+        matcher(chunks, [&] (spm::multi_haystack_hit const & hit) {
+            actual_positions[hit.haystack_id].push_back(hit.end_position + offset);
+        });
+        state = matcher.capture();
+    }
+    EXPECT_EQ(actual_positions, expected_positions());
+}
+
+TEST_F(myers_matcher_simd_test, lane_captured)
+{
+    auto matcher = get_matcher();
+    auto const initial_lane_state = matcher.capture(1);
+    EXPECT_EQ(initial_lane_state, matcher.initial_lane_state());
+
+    // Search the first haystack and keep its lane state while the second lane is reset in between.
+    std::vector<std::size_t> actual_positions{};
+    auto const & haystack = haystacks[0];
+    std::size_t const split = 12;
+    std::vector<std::span<spm::dna4 const>> first_chunk{std::span{haystack.data(), split}};
+    matcher(first_chunk, [&] (spm::multi_haystack_hit const & hit) {
+        actual_positions.push_back(hit.end_position);
+    });
+    auto const lane_state = matcher.capture(0);
+    matcher.restore(0, initial_lane_state);
+    EXPECT_EQ(matcher.capture(0), initial_lane_state);
+
+    matcher.restore(0, lane_state);
+    std::vector<std::span<spm::dna4 const>> second_chunk{std::span{haystack.data() + split, haystack.size() - split}};
+    matcher(second_chunk, [&] (spm::multi_haystack_hit const & hit) {
+        actual_positions.push_back(hit.end_position + split);
+    });
+    EXPECT_EQ(actual_positions, expected_positions()[0]);
+}
+
+TEST_F(myers_matcher_simd_test, dna15_iupac_pattern)
+{
+    auto to_dna15 = [] (std::string_view const sequence) {
+        std::vector<spm::dna15> result{};
+        for (char const symbol : sequence)
+            result.push_back(spm::dna15{symbol});
+        return result;
+    };
+
+    std::vector<std::vector<spm::dna15>> const iupac_haystacks{to_dna15("GCACGTTGCGCGTTGCTCGTTGCNCGTTGCRCGTT"),
+                                                               to_dna15("NNNNNGCGCGNN"),
+                                                               to_dna15("GCYCG")};
+    std::vector<spm::dna15> const iupac_needle = to_dna15("GCRCG");
+    spm::iupac_matching const config{.haystack_n = spm::haystack_n_policy::match};
+
+    spm::simd_myers_matcher matcher{iupac_needle, 1u, config};
+    std::vector<std::vector<std::size_t>> actual_positions(iupac_haystacks.size());
+    matcher(iupac_haystacks, [&] (spm::multi_haystack_hit const & hit) {
+        actual_positions[hit.haystack_id].push_back(hit.end_position);
+    });
+
+    for (std::size_t index = 0; index < iupac_haystacks.size(); ++index) {
+        spm::restorable_myers_matcher expected_matcher{iupac_needle, 1u, config};
+        std::vector<std::size_t> expected_positions{};
+        expected_matcher(iupac_haystacks[index], [&] (auto const & finder) {
+            expected_positions.push_back(seqan2::endPosition(finder));
+        });
+        EXPECT_EQ(actual_positions[index], expected_positions);
+    }
+}
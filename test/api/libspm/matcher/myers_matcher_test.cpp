@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <string_view>
 
 #include <libspm/seqan/alphabet.hpp>
 
@@ -51,3 +52,60 @@ TEST_F(myers_matcher_test, dna4_pattern)
     });
     EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
 }
+
+TEST_F(myers_matcher_test, dna15_iupac_pattern)
+{
+    auto to_dna15 = [] (std::string_view const sequence) {
+        std::vector<spm::dna15> result{};
+        for (char const symbol : sequence)
+            result.push_back(spm::dna15{symbol});
+        return result;
+    };
+                                                               //0         1         2         3
+                                                               //01234567890123456789012345678901234
+    std::vector<spm::dna15> const iupac_haystack = to_dna15("GCACGTTGCGCGTTGCTCGTTGCNCGTTGCRCGTT");
+    std::vector<spm::dna15> const iupac_needle = to_dna15("GCRCG");
+
+    auto search = [&] (spm::haystack_n_policy const policy) {
+        spm::myers_matcher matcher{iupac_needle, 0, spm::iupac_matching{.haystack_n = policy}};
+        std::vector<size_t> actual_positions{};
+        matcher(iupac_haystack, [&] (auto const & finder) {
+            actual_positions.push_back(seqan2::endPosition(finder));
+        });
+        return actual_positions;
+    };
+
+    EXPECT_EQ(search(spm::haystack_n_policy::mismatch), (std::vector<std::size_t>{5, 12, 33}));
+    EXPECT_EQ(search(spm::haystack_n_policy::match), (std::vector<std::size_t>{5, 12, 26, 33}));
+}
+
+TEST_F(myers_matcher_test, rebind_keeps_iupac_matching)
+{
+    auto to_dna15 = [] (std::string_view const sequence) {
+        std::vector<spm::dna15> result{};
+        for (char const symbol : sequence)
+            result.push_back(spm::dna15{symbol});
+        return result;
+    };
+
+    std::vector<spm::dna15> const iupac_haystack = to_dna15("GCACGTTGCGCGTTGCTCGTTGCNCGTTGCRCGTT");
+    std::vector<spm::dna15> const initial_needle = to_dna15("TTTTTTT");
+    std::vector<spm::dna15> const iupac_needle = to_dna15("GCRCG");
+
+    spm::myers_matcher matcher{initial_needle, 2, spm::iupac_matching{.haystack_n = spm::haystack_n_policy::match}};
+    matcher.rebind(iupac_needle, 0);
+
+    std::vector<size_t> actual_positions{};
+    matcher(iupac_haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::endPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{5, 12, 26, 33}));
+}
+
+TEST_F(myers_matcher_test, count_and_contains)
+{
+    auto matcher = get_matcher();
+    EXPECT_EQ(spm::count(matcher, haystack), expected_positions.size());
+    EXPECT_TRUE(spm::contains(matcher, haystack));
+    EXPECT_FALSE(spm::contains(matcher, "TTTTTTTTTT"_dna4));
+}
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <optional>
 
 #include <libspm/seqan/alphabet.hpp>
 
@@ -62,6 +63,21 @@ TEST_F(pigeonhole_matcher_test, dna4_pattern)
     EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
 }
 
+TEST_F(pigeonhole_matcher_test, copy_shares_needle_index)
+{
+    std::optional<decltype(get_matcher())> copy{};
+    {
+        auto matcher = get_matcher();
+        copy.emplace(matcher);
+    } // the needle index is owned by the copy as well.
+
+    std::vector<size_t> actual_positions{};
+    (*copy)(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
+}
+
 TEST_F(pigeonhole_matcher_test, dna4_multi_pattern)
 {
     auto matcher = get_multi_matcher();
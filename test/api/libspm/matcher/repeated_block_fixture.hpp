@@ -0,0 +1,48 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the test fixture with a repeated block haystack shared by the incremental search tests.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+
+using spm::operator""_dna4;
+
+//!\brief A haystack of 20 copies of a block with several approximate hits of the needle in every copy.
+struct repeated_block_fixture : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using matcher_t = spm::fixed_length_myers_matcher<32, spm::dna4>;
+
+    sequence_t haystack{};
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t errors = 1;
+
+    void SetUp() override {
+        sequence_t const block = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+        for (std::size_t i = 0; i < 20; ++i)
+            haystack.insert(haystack.end(), block.begin(), block.end());
+    }
+
+    //!\brief Returns the hits of an uninterrupted search over the current haystack.
+    std::vector<spm::matcher_hit> full_search() const {
+        std::vector<spm::matcher_hit> hits{};
+        matcher_t matcher{needle, errors};
+        matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { hits.push_back(hit); });
+        return hits;
+    }
+};
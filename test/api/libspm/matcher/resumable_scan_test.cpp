@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/resumable_scan.hpp>
+#include <libspm/matcher/trie_myers_matcher.hpp>
+
+#include "repeated_block_fixture.hpp"
+
+struct resumable_scan_test : public repeated_block_fixture {
+    sequence_t other_needle = "AAAA"_dna4;
+    std::filesystem::path checkpoint_path{};
+
+    void SetUp() override {
+        repeated_block_fixture::SetUp();
+
+        // A unique file per test and process, such that concurrently running tests do not share a checkpoint.
+        std::string const test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        checkpoint_path = std::filesystem::temp_directory_path() /
+                          ("libspm_resumable_scan_test_" + test_name + "_" +
+                           std::to_string(std::random_device{}()) + ".ckpt");
+        std::filesystem::remove(checkpoint_path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(checkpoint_path);
+        std::filesystem::remove(std::filesystem::path{checkpoint_path} += ".tmp");
+    }
+
+    template <typename value_t>
+    static value_t round_trip(value_t const & value, value_t result) {
+        std::stringstream stream{};
+        {
+            cereal::BinaryOutputArchive archive{stream};
+            archive(value);
+        }
+        cereal::BinaryInputArchive archive{stream};
+        archive(result);
+        return result;
+    }
+};
+
+TEST_F(resumable_scan_test, serialise_state) {
+    sequence_t const prefix{haystack.begin(), haystack.begin() + 13};
+    matcher_t matcher{needle, errors};
+    matcher(prefix, [] (spm::matcher_hit const &) {});
+    EXPECT_EQ(round_trip(matcher.capture(), matcher_t::state_type{}), matcher.capture());
+
+    // The restorable Myers matcher resumes from the deserialised state with the hits of an uninterrupted search, for
+    // a needle fitting into a single word and for a needle held in the large state of several blocks.
+    std::size_t const split = 113;
+    sequence_t const long_needle{haystack.begin() + 3, haystack.begin() + 73};
+    std::vector<std::pair<sequence_t, std::size_t>> const configurations{{needle, errors}, {long_needle, 4}};
+    for (auto const & [myers_needle, myers_errors] : configurations) {
+        auto search = [&] (auto & myers_matcher, std::size_t const begin, std::size_t const end, auto & hits) {
+            myers_matcher(std::span{haystack}.subspan(begin, end - begin), begin, [&] (auto const & hit) {
+                hits.push_back(hit.end_position);
+            });
+        };
+
+        std::vector<std::size_t> expected_hits{};
+        spm::restorable_myers_matcher uninterrupted_matcher{myers_needle, myers_errors};
+        search(uninterrupted_matcher, 0, haystack.size(), expected_hits);
+
+        std::vector<std::size_t> actual_hits{};
+        spm::restorable_myers_matcher interrupted_matcher{myers_needle, myers_errors};
+        search(interrupted_matcher, 0, split, actual_hits);
+        auto const state = round_trip(interrupted_matcher.capture(), decltype(interrupted_matcher)::state_type{});
+
+        spm::restorable_myers_matcher resumed_matcher{myers_needle, myers_errors};
+        resumed_matcher.restore(state);
+        search(resumed_matcher, split, haystack.size(), actual_hits);
+        EXPECT_FALSE(expected_hits.empty());
+        EXPECT_EQ(actual_hits, expected_hits);
+    }
+}
+
+TEST_F(resumable_scan_test, serialise_matcher) {
+    sequence_t const prefix{haystack.begin(), haystack.begin() + 13};
+    matcher_t matcher{needle, errors};
+    matcher(prefix, [] (spm::matcher_hit const &) {});
+    matcher_t loaded_matcher = round_trip(matcher, matcher_t{other_needle, 0});
+    EXPECT_EQ(spm::window_size(loaded_matcher), spm::window_size(matcher));
+    EXPECT_EQ(loaded_matcher.capture(), matcher.capture());
+
+    std::vector<sequence_t> const needles{needle, "TGACTAGC"_dna4};
+    std::vector<sequence_t> const other_needles{other_needle};
+    spm::trie_myers_matcher trie_matcher{needles, errors};
+    spm::trie_myers_matcher loaded_trie_matcher = round_trip(trie_matcher, spm::trie_myers_matcher{other_needles});
+    std::vector<spm::needle_hit> expected_hits{};
+    std::vector<spm::needle_hit> actual_hits{};
+    trie_matcher(haystack, [&] (spm::needle_hit const & hit) { expected_hits.push_back(hit); });
+    loaded_trie_matcher(haystack, [&] (spm::needle_hit const & hit) { actual_hits.push_back(hit); });
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+TEST_F(resumable_scan_test, resume) {
+    std::vector<spm::matcher_hit> actual_hits{};
+    std::size_t run_count{};
+    spm::search_control control{spm::search_control::stop};
+    // Every run is terminated after more hits than fit into one checkpoint interval and restarted from the file.
+    while (control == spm::search_control::stop) {
+        spm::resumable_scan scan{matcher_t{needle, errors}, checkpoint_path, 64};
+        actual_hits.resize(scan.hit_count());
+
+        std::size_t hit_count{};
+        control = scan(haystack, [&] (spm::matcher_hit const & hit) {
+            actual_hits.push_back(hit);
+            return (++hit_count == 20) ? spm::search_control::stop : spm::search_control::proceed;
+        });
+        ++run_count;
+    }
+    EXPECT_GT(run_count, 1u);
+    EXPECT_EQ(actual_hits, full_search());
+
+    spm::resumable_scan finished_scan{matcher_t{needle, errors}, checkpoint_path, 64};
+    EXPECT_EQ(finished_scan.offset(), haystack.size());
+    EXPECT_EQ(finished_scan.hit_count(), actual_hits.size());
+}
+
+TEST_F(resumable_scan_test, malformed_checkpoint) {
+    {
+        std::ofstream stream{checkpoint_path, std::ios::binary};
+        stream << 'x';
+    }
+    EXPECT_THROW((spm::resumable_scan{matcher_t{needle, errors}, checkpoint_path}), std::runtime_error);
+}
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <string_view>
 
 #include <libspm/seqan/alphabet.hpp>
 
@@ -15,6 +16,7 @@
 #include <libspm/matcher/shiftor_matcher.hpp>
 
 using spm::operator""_dna4;
+using spm::operator""_dna5;
 
 struct shiftor_matcher_test : public ::testing::Test {
     using sequence_t = std::vector<spm::dna4>;
@@ -50,3 +52,141 @@ TEST_F(shiftor_matcher_test, dna4_pattern)
     });
     EXPECT_TRUE(std::ranges::equal(actual_positions, expected_positions));
 }
+
+TEST_F(shiftor_matcher_test, dna4_pattern_subrange)
+{
+    auto matcher = get_matcher();
+
+    std::size_t const offset = 7;
+    std::vector<spm::matcher_hit> actual_hits{};
+    matcher(std::ranges::subrange{haystack.begin() + offset, haystack.end()}, offset, [&] (spm::matcher_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+
+    std::vector<spm::matcher_hit> expected_hits{{9, 14}, {20, 25}, {31, 36}};
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+struct shiftor_matcher_iupac_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna15>;
+
+    static sequence_t to_dna15(std::string_view const sequence) {
+        sequence_t result{};
+        for (char const symbol : sequence)
+            result.push_back(spm::dna15{symbol});
+        return result;
+    }
+                                          //0         1         2         3
+                                          //01234567890123456789012345678901234
+    sequence_t haystack = to_dna15("GCACGTTGCGCGTTGCTCGTTGCNCGTTGCRCGTT");
+    sequence_t needle = to_dna15("GCRCG");
+};
+
+TEST_F(shiftor_matcher_iupac_test, haystack_n_mismatch)
+{
+    spm::shiftor_matcher matcher{needle, spm::iupac_matching{.haystack_n = spm::haystack_n_policy::mismatch}};
+
+    std::vector<size_t> actual_positions{};
+    matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{0, 7, 28}));
+}
+
+TEST_F(shiftor_matcher_iupac_test, haystack_n_match)
+{
+    spm::shiftor_matcher matcher{needle, spm::iupac_matching{.haystack_n = spm::haystack_n_policy::match}};
+
+    std::vector<size_t> actual_positions{};
+    matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{0, 7, 21, 28}));
+}
+
+TEST_F(shiftor_matcher_iupac_test, set_needle_keeps_iupac_matching)
+{
+    sequence_t const initial_needle = to_dna15("TTTTT");
+    spm::shiftor_matcher matcher{initial_needle, spm::iupac_matching{.haystack_n = spm::haystack_n_policy::match}};
+    matcher.set_needle(needle);
+
+    std::vector<size_t> actual_positions{};
+    matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{0, 7, 21, 28}));
+}
+
+TEST_F(shiftor_matcher_iupac_test, exact_by_default)
+{
+    spm::shiftor_matcher matcher{needle};
+
+    std::vector<size_t> actual_positions{};
+    matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{28}));
+}
+
+TEST_F(shiftor_matcher_test, count_and_contains)
+{
+    auto matcher = get_matcher();
+    EXPECT_EQ(spm::count(matcher, haystack), expected_positions.size());
+    EXPECT_TRUE(spm::contains(matcher, haystack));
+    EXPECT_EQ(spm::count(matcher, "TTTTTTTTTT"_dna4), 0u);
+    EXPECT_FALSE(spm::contains(matcher, "TTTTTTTTTT"_dna4));
+
+    // Needles exceeding a machine word are counted through the finder.
+    sequence_t const long_haystack = [&] () {
+        sequence_t result{};
+        for (std::size_t repeat = 0; repeat < 4; ++repeat)
+            result.insert(result.end(), haystack.begin(), haystack.end());
+        return result;
+    }();
+    sequence_t const long_needle{haystack.begin(), haystack.begin() + 40};
+    spm::shiftor_matcher long_matcher{long_needle};
+    EXPECT_EQ(spm::count(long_matcher, long_haystack), 13u); // the haystack has a period of 11.
+    EXPECT_TRUE(spm::contains(long_matcher, long_haystack));
+}
+
+TEST_F(shiftor_matcher_test, count_mixed_alphabets)
+{
+    auto count_hits = [] (auto & matcher, auto const & haystack) {
+        std::size_t hit_count{};
+        matcher(haystack, [&] (auto const &) { ++hit_count; });
+        return hit_count;
+    };
+
+    // The haystack symbols are converted to the needle alphabet, i.e. a haystack `N` becomes an `A` of the needle.
+    std::vector<spm::dna5> const dna5_haystack = "ACGTNACGTAACGTNNACGTA"_dna5;
+    sequence_t const dna4_needle = "GTA"_dna4;
+    spm::shiftor_matcher dna4_matcher{dna4_needle};
+    EXPECT_EQ(spm::count(dna4_matcher, dna5_haystack), count_hits(dna4_matcher, dna5_haystack));
+    EXPECT_EQ(spm::count(dna4_matcher, dna5_haystack), 4u);
+
+    std::vector<spm::dna15> const dna15_needle{spm::dna15{'C'}, spm::dna15{'G'}, spm::dna15{'T'}};
+    spm::shiftor_matcher dna15_matcher{dna15_needle};
+    EXPECT_EQ(spm::count(dna15_matcher, haystack), count_hits(dna15_matcher, haystack));
+    EXPECT_EQ(spm::count(dna15_matcher, haystack), 4u);
+}
+
+TEST_F(shiftor_matcher_test, set_needle)
+{
+    auto matcher = get_matcher();
+    sequence_t const other_needle = "TGACTAGC"_dna4;
+    matcher.set_needle(other_needle);
+    EXPECT_EQ(spm::window_size(matcher), std::ranges::size(other_needle));
+
+    std::vector<size_t> actual_positions{};
+    matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, (std::vector<std::size_t>{3, 14, 25, 36}));
+
+    matcher.set_needle(needle);
+    actual_positions.clear();
+    matcher(haystack, [&] (auto const & finder) {
+        actual_positions.push_back(seqan2::beginPosition(finder));
+    });
+    EXPECT_EQ(actual_positions, expected_positions);
+}
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <ranges>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/stratified_search.hpp>
+
+using spm::operator""_dna4;
+
+struct stratified_search_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACCTGACTAGCACGTGACTAGC"_dna4;
+    sequence_t needle = "GCACG"_dna4;
+    std::size_t max_errors = 2;
+
+    // Determines the error count of every end position by iterative deepening.
+    std::map<std::size_t, std::size_t> expected_error_counts() const {
+        std::map<std::size_t, std::size_t> error_counts{};
+        for (std::size_t errors = 0; errors <= max_errors; ++errors) {
+            spm::myers_matcher matcher{needle, errors};
+            matcher(haystack, [&] (auto const & finder) {
+                error_counts.emplace(seqan2::endPosition(finder), errors);
+            });
+        }
+        return error_counts;
+    }
+
+    std::vector<spm::scored_hit> expected_hits(std::size_t const delta) const {
+        std::map<std::size_t, std::size_t> const error_counts = expected_error_counts();
+        std::size_t best = max_errors;
+        for (auto const & [end_position, errors] : error_counts)
+            best = std::min(best, errors);
+
+        std::vector<spm::scored_hit> hits{};
+        for (auto const & [end_position, errors] : error_counts)
+            if (errors <= best + delta)
+                hits.push_back(spm::scored_hit{end_position - std::min(end_position, needle.size() + max_errors),
+                                               end_position,
+                                               errors});
+        return hits;
+    }
+};
+
+TEST_F(stratified_search_test, concept_tests) {
+    EXPECT_TRUE(spm::scored_matcher<spm::myers_matcher<std::views::all_t<sequence_t &>>>);
+    EXPECT_TRUE(spm::scored_matcher<spm::restorable_myers_matcher<std::views::all_t<sequence_t &>>>);
+}
+
+TEST_F(stratified_search_test, scored_search)
+{
+    spm::restorable_myers_matcher matcher{needle, max_errors};
+
+    std::vector<spm::scored_hit> actual_hits{};
+    spm::scored_search(matcher, haystack, 0, [&] (spm::scored_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+    EXPECT_EQ(actual_hits, expected_hits(max_errors));
+}
+
+TEST_F(stratified_search_test, best_stratum)
+{
+    spm::myers_matcher matcher{needle, max_errors};
+
+    std::vector<spm::scored_hit> actual_hits{};
+    spm::stratified_search(matcher, haystack, spm::stratum_policy{}, [&] (spm::scored_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+    EXPECT_EQ(actual_hits.size(), 2u); // the third occurrence has a mismatch.
+    EXPECT_EQ(actual_hits, expected_hits(0));
+}
+
+TEST_F(stratified_search_test, best_plus_delta)
+{
+    spm::restorable_myers_matcher matcher{needle, max_errors};
+
+    std::vector<spm::scored_hit> actual_hits{};
+    spm::stratified_search(matcher, haystack, spm::stratum_policy{.delta = 1}, [&] (spm::scored_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+    EXPECT_EQ(actual_hits, expected_hits(1));
+}
+
+TEST_F(stratified_search_test, collector_over_chunks)
+{
+    spm::restorable_myers_matcher matcher{needle, max_errors};
+    spm::stratum_collector collector{spm::stratum_policy{.delta = 1}};
+
+    std::size_t const split = 23;
+    spm::scored_search(matcher, std::ranges::subrange{haystack.begin(), haystack.begin() + split}, 0, collector);
+    spm::scored_search(matcher, std::ranges::subrange{haystack.begin() + split, haystack.end()}, split, collector);
+    EXPECT_EQ(collector.best_error_count(), 0u);
+
+    std::vector<spm::scored_hit> actual_hits{};
+    collector.flush([&] (spm::scored_hit const & hit) {
+        actual_hits.push_back(hit);
+    });
+    EXPECT_EQ(actual_hits, expected_hits(1));
+}
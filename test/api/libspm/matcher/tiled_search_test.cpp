@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/myers_matcher_restorable.hpp>
+#include <libspm/matcher/search_control.hpp>
+#include <libspm/matcher/tiled_search.hpp>
+
+using spm::operator""_dna4;
+
+// Forwards to a restorable myers matcher and throws from within its search once a hit ends at the given position.
+template <typename matcher_t>
+struct throwing_matcher {
+    matcher_t matcher;
+    std::size_t throw_position{};
+
+    constexpr std::size_t window_size() const noexcept { return spm::window_size(matcher); }
+    constexpr auto capture() const noexcept { return spm::capture(matcher); }
+    constexpr void restore(spm::matcher_state_t<matcher_t &> const & state) noexcept { spm::restore(matcher, state); }
+
+    template <typename haystack_t, typename callback_t>
+    spm::search_control operator()(haystack_t && haystack, std::size_t const offset, callback_t && callback) {
+        return matcher((haystack_t &&) haystack, offset, [&] (spm::matcher_hit const & hit) {
+            if (hit.end_position >= throw_position)
+                throw std::runtime_error{"search failure"};
+            return spm::detail::invoke_hit_callback(callback, hit);
+        });
+    }
+};
+
+struct tiled_search_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using hit_t = std::pair<std::size_t, spm::matcher_hit>;
+
+    sequence_t haystack{};
+    std::vector<sequence_t> needles{"GCACG"_dna4, "TGACTAGC"_dna4, "ACGTGA"_dna4, "CTAGCACGTG"_dna4};
+    std::size_t errors = 1;
+
+    void SetUp() override {
+        sequence_t const block = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+        for (std::size_t i = 0; i < 20; ++i)
+            haystack.insert(haystack.end(), block.begin(), block.end());
+    }
+
+    auto make_matchers() const {
+        using matcher_t = decltype(spm::restorable_myers_matcher{needles[0], errors});
+        std::vector<matcher_t> matchers{};
+        for (sequence_t const & needle : needles)
+            matchers.emplace_back(needle, errors);
+        return matchers;
+    }
+
+    // The hits of searching the complete haystack with one matcher after the other.
+    std::vector<hit_t> separate_hits() const {
+        std::vector<hit_t> hits{};
+        auto matchers = make_matchers();
+        for (std::size_t index = 0; index < matchers.size(); ++index)
+            matchers[index](haystack, 0, [&] (spm::matcher_hit const & hit) { hits.emplace_back(index, hit); });
+        return hits;
+    }
+};
+
+TEST_F(tiled_search_test, same_hits_as_separate_searches) {
+    auto const matchers = make_matchers();
+    std::vector<hit_t> const expected_hits = separate_hits();
+    EXPECT_FALSE(expected_hits.empty());
+
+    for (std::size_t const tile_bytes : {1u, 7u, 64u, 1024u}) {
+        for (std::size_t const thread_count : {1u, 2u, 8u}) {
+            std::vector<hit_t> actual_hits{};
+            spm::tiled_search(matchers, haystack, [&] (std::size_t const index, spm::matcher_hit const & hit) {
+                actual_hits.emplace_back(index, hit);
+            }, tile_bytes, thread_count);
+
+            // The hits are reported tile by tile and within a tile by matcher.
+            std::size_t const tile_size = std::max<std::size_t>(tile_bytes / sizeof(spm::dna4), 1);
+            auto tile_of = [&] (hit_t const & hit) { return (hit.second.end_position - 1) / tile_size; };
+            EXPECT_TRUE(std::ranges::is_sorted(actual_hits, std::ranges::less{}, [&] (hit_t const & hit) {
+                return std::pair{tile_of(hit), hit.first};
+            })) << "tile_bytes: " << tile_bytes << " threads: " << thread_count;
+
+            std::ranges::stable_sort(actual_hits, std::ranges::less{}, &hit_t::first);
+            EXPECT_EQ(actual_hits, expected_hits) << "tile_bytes: " << tile_bytes << " threads: " << thread_count;
+        }
+    }
+}
+
+TEST_F(tiled_search_test, callback_exception) {
+    auto const matchers = make_matchers();
+    for (std::size_t const thread_count : {1u, 2u, 8u}) {
+        std::size_t hit_count{};
+        EXPECT_THROW(spm::tiled_search(matchers, haystack, [&] (std::size_t, spm::matcher_hit const &) {
+            if (++hit_count == 3)
+                throw std::runtime_error{"stop"};
+        }, 7, thread_count), std::runtime_error);
+        EXPECT_EQ(hit_count, 3u);
+    }
+}
+
+TEST_F(tiled_search_test, matcher_exception) {
+    using matcher_t = std::ranges::range_value_t<decltype(make_matchers())>;
+    std::vector<throwing_matcher<matcher_t>> matchers{};
+    for (matcher_t const & matcher : make_matchers())
+        matchers.push_back({.matcher = matcher, .throw_position = haystack.size() / 2});
+
+    for (std::size_t const thread_count : {1u, 2u, 8u}) {
+        std::size_t hit_count{};
+        EXPECT_THROW(spm::tiled_search(matchers, haystack, [&] (std::size_t, spm::matcher_hit const & hit) {
+            EXPECT_LT(hit.end_position, haystack.size() / 2);
+            ++hit_count;
+        }, 7, thread_count), std::runtime_error);
+        EXPECT_GT(hit_count, 0u);
+    }
+}
+
+TEST_F(tiled_search_test, empty) {
+    auto const matchers = make_matchers();
+    std::size_t hit_count{};
+    spm::tiled_search(matchers, sequence_t{}, [&] (std::size_t, spm::matcher_hit const &) { ++hit_count; });
+    spm::tiled_search(decltype(matchers){}, haystack, [&] (std::size_t, spm::matcher_hit const &) { ++hit_count; });
+    EXPECT_EQ(hit_count, 0u);
+}
@@ -0,0 +1,118 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/stratified_search.hpp>
+#include <libspm/matcher/trie_myers_matcher.hpp>
+
+using spm::operator""_dna4;
+
+struct trie_myers_matcher_test : public ::testing::Test {
+    using sequence_t = std::vector<spm::dna4>;
+    using hit_t = std::tuple<std::size_t, std::size_t, std::size_t>; // end position, needle id, error count
+                         //0         1         2         3         4
+                         //012345678901234567890123456789012345678901234
+    sequence_t haystack = "ACGTGACTAGCACGTGACTAGCACGTGACTAGCACGTGACTAGC"_dna4;
+    std::vector<sequence_t> needles{"GCACG"_dna4, "GCACT"_dna4, "GCA"_dna4, "TGACTAGC"_dna4, "GCACG"_dna4};
+    std::size_t errors = 1;
+
+    // The hits of separate Myers searches per needle.
+    std::vector<hit_t> expected_hits() const {
+        std::vector<hit_t> hits{};
+        for (std::size_t needle_id = 0; needle_id < needles.size(); ++needle_id) {
+            spm::myers_matcher matcher{needles[needle_id], errors};
+            spm::scored_search(matcher, haystack, 0, [&] (spm::scored_hit const & hit) {
+                hits.emplace_back(hit.end_position, needle_id, hit.error_count);
+            });
+        }
+        std::ranges::sort(hits);
+        return hits;
+    }
+};
+
+TEST_F(trie_myers_matcher_test, concept_tests) {
+    using matcher_t = spm::trie_myers_matcher<spm::dna4>;
+    EXPECT_TRUE(spm::window_matcher<matcher_t>);
+    EXPECT_TRUE(spm::restorable_matcher<matcher_t>);
+}
+
+TEST_F(trie_myers_matcher_test, shared_prefixes) {
+    spm::trie_myers_matcher matcher{needles, errors};
+    EXPECT_EQ(matcher.needle_count(), needles.size());
+    EXPECT_EQ(matcher.node_count(), 5u); // GCA, C, G, T and TGACTAGC.
+    EXPECT_EQ(spm::window_size(matcher), 8u + errors);
+
+    std::vector<hit_t> actual_hits{};
+    matcher(haystack, [&] (spm::needle_hit const & hit) {
+        EXPECT_EQ(hit.begin_position,
+                  hit.end_position - std::min(hit.end_position, needles[hit.needle_id].size() + errors));
+        actual_hits.emplace_back(hit.end_position, hit.needle_id, hit.error_count);
+    });
+    std::ranges::sort(actual_hits);
+    EXPECT_EQ(actual_hits, expected_hits());
+}
+
+TEST_F(trie_myers_matcher_test, long_needles) {
+    // Needles longer than a word are split into several nodes along the shared path.
+    sequence_t long_haystack{};
+    for (std::size_t i = 0; i < 8; ++i)
+        long_haystack.insert(long_haystack.end(), haystack.begin(), haystack.end());
+
+    std::vector<sequence_t> long_needles{sequence_t(long_haystack.begin() + 3, long_haystack.begin() + 140),
+                                         sequence_t(long_haystack.begin() + 3, long_haystack.begin() + 70)};
+    long_needles[0][100] = 'A'_dna4;
+    long_needles[1].push_back('T'_dna4);
+
+    spm::trie_myers_matcher matcher{long_needles, 2};
+    std::vector<hit_t> actual_hits{};
+    matcher(long_haystack, [&] (spm::needle_hit const & hit) {
+        actual_hits.emplace_back(hit.end_position, hit.needle_id, hit.error_count);
+    });
+
+    std::vector<hit_t> expected{};
+    for (std::size_t needle_id = 0; needle_id < long_needles.size(); ++needle_id) {
+        spm::myers_matcher single_matcher{long_needles[needle_id], 2u};
+        spm::scored_search(single_matcher, long_haystack, 0, [&] (spm::scored_hit const & hit) {
+            expected.emplace_back(hit.end_position, needle_id, hit.error_count);
+        });
+    }
+    std::ranges::sort(actual_hits);
+    std::ranges::sort(expected);
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(actual_hits, expected);
+}
+
+TEST_F(trie_myers_matcher_test, capture_and_restore) {
+    spm::trie_myers_matcher matcher{needles, errors};
+    auto const initial_state = matcher.capture();
+
+    std::vector<hit_t> actual_hits{};
+    auto collect = [&] (spm::needle_hit const & hit) {
+        actual_hits.emplace_back(hit.end_position, hit.needle_id, hit.error_count);
+    };
+    std::span const haystack_span{haystack};
+    matcher(haystack_span.first(20), 0, collect);
+    auto const state = matcher.capture();
+
+    matcher.restore(initial_state);
+    matcher(haystack_span.first(10), 0, [] (spm::needle_hit const &) {});
+
+    matcher.restore(state);
+    matcher(haystack_span.subspan(20), 20, collect);
+    std::ranges::sort(actual_hits);
+    EXPECT_EQ(actual_hits, expected_hits());
+}
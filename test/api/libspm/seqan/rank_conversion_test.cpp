@@ -0,0 +1,143 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+
+#include <libspm/seqan/alphabet.hpp>
+#include <libspm/seqan/rank_conversion.hpp>
+
+template <typename t>
+struct rank_conversion_test : ::testing::Test
+{
+    using alphabet_t = t;
+
+    static std::vector<uint8_t> expected_ranks(std::string const & text)
+    {
+        std::vector<uint8_t> ranks{};
+        for (char const c : text)
+            ranks.push_back(seqan3::to_rank(seqan3::assign_char_to(c, alphabet_t{})));
+        return ranks;
+    }
+};
+
+using test_types = ::testing::Types<
+    spm::dna4,
+    spm::dna5,
+    spm::dna15
+>;
+
+TYPED_TEST_SUITE(rank_conversion_test, test_types);
+
+TYPED_TEST(rank_conversion_test, char_to_rank_table)
+{
+    using alphabet_t = typename TestFixture::alphabet_t;
+
+    EXPECT_TRUE(spm::rank_convertible_alphabet<alphabet_t>);
+    for (std::size_t c = 0; c < 256; ++c)
+        EXPECT_EQ(spm::char_to_rank_table<alphabet_t>[c],
+                  seqan3::to_rank(seqan3::assign_char_to(static_cast<char>(c), alphabet_t{})));
+
+    constexpr uint8_t rank_of_g = spm::char_to_rank_table<alphabet_t>['G'];
+    EXPECT_EQ(rank_of_g, seqan3::to_rank(seqan3::assign_char_to('G', alphabet_t{})));
+}
+
+TYPED_TEST(rank_conversion_test, to_rank_letters)
+{
+    std::string text{};
+    for (std::size_t repeat = 0; repeat < 10; ++repeat)
+        text += "ACGTNacgtnRYKMSWBDHVUu-";
+
+    // Convert all prefixes to cover the vectorised blocks and the remaining characters.
+    for (std::size_t size = 0; size <= text.size(); ++size) {
+        std::string const prefix = text.substr(0, size);
+        std::vector<uint8_t> ranks(size);
+        spm::to_rank<typename TestFixture::alphabet_t>(prefix, ranks);
+        EXPECT_EQ(ranks, TestFixture::expected_ranks(prefix));
+    }
+}
+
+TYPED_TEST(rank_conversion_test, to_rank_letter_blocks)
+{
+    using alphabet_t = typename TestFixture::alphabet_t;
+
+    // Only characters of the letter range, such that every block takes the vectorised path.
+    std::string const letters{"ACGTNacgtnRYKMSWBDHVUu"};
+    std::mt19937 generator{42};
+    for (std::size_t const size : {16u, 32u, 1000u, 1003u, 4096u + 17u}) {
+        std::string text(size, '\0');
+        for (char & c : text)
+            c = (generator() % 4 == 0) ? static_cast<char>(0x40 + generator() % 0x40)
+                                       : letters[generator() % letters.size()];
+
+        std::vector<uint8_t> ranks(text.size());
+        spm::to_rank<alphabet_t>(text, ranks);
+
+        std::vector<uint8_t> scalar_ranks(text.size());
+        spm::detail::to_rank_scalar<alphabet_t>(text.data(), scalar_ranks.data(), text.size());
+        EXPECT_EQ(ranks, scalar_ranks) << "size: " << size;
+        EXPECT_EQ(ranks, TestFixture::expected_ranks(text)) << "size: " << size;
+    }
+}
+
+TYPED_TEST(rank_conversion_test, to_rank_all_chars)
+{
+    std::mt19937 generator{42};
+    std::string text(1000, '\0');
+    for (char & c : text)
+        c = static_cast<char>(generator() % 256);
+
+    std::vector<uint8_t> ranks(text.size());
+    spm::to_rank<typename TestFixture::alphabet_t>(text, ranks);
+    EXPECT_EQ(ranks, TestFixture::expected_ranks(text));
+}
+
+TYPED_TEST(rank_conversion_test, to_rank_empty)
+{
+    std::vector<uint8_t> ranks{};
+    spm::to_rank<typename TestFixture::alphabet_t>(std::string{}, ranks);
+    EXPECT_TRUE(ranks.empty());
+}
+
+TYPED_TEST(rank_conversion_test, adaptor_char_conversion)
+{
+    using alphabet_t = typename TestFixture::alphabet_t;
+    using wrapped_t = decltype(alphabet_t{}._symbol);
+
+    // The adaptor converts through the rank table of the wrapped alphabet.
+    for (std::size_t c = 0; c < 256; ++c) {
+        uint8_t const expected = seqan3::to_rank(seqan3::assign_char_to(static_cast<char>(c), wrapped_t{}));
+        EXPECT_EQ(seqan3::to_rank(alphabet_t{static_cast<char>(c)}), expected);
+        EXPECT_EQ(seqan3::to_rank(seqan3::assign_char_to(static_cast<char>(c), alphabet_t{})), expected);
+    }
+}
+
+TYPED_TEST(rank_conversion_test, to_symbols)
+{
+    using alphabet_t = typename TestFixture::alphabet_t;
+
+    std::mt19937 generator{42};
+    for (std::size_t const size : {0u, 15u, 1024u, 1024u + 33u, 4096u + 17u}) {
+        std::string text(size, '\0');
+        for (char & c : text)
+            c = static_cast<char>(generator() % 256);
+
+        std::vector<alphabet_t> symbols(text.size());
+        spm::to_symbols<alphabet_t>(text, symbols);
+
+        std::vector<uint8_t> ranks{};
+        for (alphabet_t const symbol : symbols)
+            ranks.push_back(seqan3::to_rank(symbol));
+        EXPECT_EQ(ranks, TestFixture::expected_ranks(text)) << "size: " << size;
+    }
+}
@@ -0,0 +1,48 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the sequence generation and the counters shared by the matcher benchmarks.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+using sequence_t = std::vector<spm::dna4>;
+
+//!\brief Generates a random dna4 sequence; equal seeds generate equal sequences.
+inline sequence_t generate_sequence(std::size_t const size, uint32_t const seed) {
+    std::mt19937 random_engine{seed};
+    sequence_t sequence(size);
+    std::ranges::generate(sequence, [&] () { return spm::dna4{static_cast<uint8_t>(random_engine() % 4)}; });
+    return sequence;
+}
+
+//!\brief Constructs the matcher with the number of errors if it is an approximate matcher and without otherwise.
+template <typename matcher_t>
+matcher_t construct_matcher(sequence_t const & needle, std::size_t const error_count) {
+    if constexpr (std::constructible_from<matcher_t, sequence_t const &, std::size_t>)
+        return matcher_t{needle, error_count};
+    else
+        return matcher_t{needle};
+}
+
+//!\brief Reports the haystack bytes searched per second.
+inline void set_bytes_counter(benchmark::State & state, std::size_t const haystack_bytes) {
+    state.counters["bytes"] = benchmark::Counter(static_cast<double>(haystack_bytes),
+                                                 benchmark::Counter::kIsIterationInvariantRate);
+}
@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/checkpointed_search.hpp>
+#include <libspm/matcher/fixed_length_matcher.hpp>
+
+#include "benchmark_utility.hpp"
+
+using matcher_t = spm::fixed_length_myers_matcher<64, spm::dna4>;
+
+inline constexpr std::size_t haystack_size = 1 << 24;
+
+static void full_search(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(haystack_size, 42);
+    spm::checkpointed_search search{matcher_t{generate_sequence(50, 7), 4u}, static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        search.search(haystack);
+        benchmark::DoNotOptimize(search.hits().data());
+    }
+}
+
+// Substitutes a random symbol per iteration and updates the hits.
+static void update(benchmark::State & state) {
+    sequence_t haystack = generate_sequence(haystack_size, 42);
+    spm::checkpointed_search search{matcher_t{generate_sequence(50, 7), 4u}, static_cast<std::size_t>(state.range(0))};
+    search.search(haystack);
+
+    std::mt19937 random_engine{13};
+    std::size_t rescanned_size{};
+    for (auto _ : state) {
+        std::size_t const position = random_engine() % haystack_size;
+        haystack[position] = spm::dna4{static_cast<uint8_t>(random_engine() % 4)};
+        rescanned_size += search.update(haystack, spm::haystack_edit{.position = position,
+                                                                     .erased_size = 1,
+                                                                     .inserted_size = 1});
+        benchmark::DoNotOptimize(search.hits().data());
+    }
+    state.counters["rescanned"] = benchmark::Counter(static_cast<double>(rescanned_size),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(full_search)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(update)->Arg(256)->Arg(4096)->Arg(65536)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
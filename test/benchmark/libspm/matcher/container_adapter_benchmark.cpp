@@ -0,0 +1,100 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <ranges>
+#include <vector>
+
+#include <seqan/find.h>
+#include <seqan/sequence.h>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+
+#include "benchmark_utility.hpp"
+
+struct vector_haystack {
+    static auto const & adapt(sequence_t const & haystack) noexcept {
+        return haystack; // searched through the contiguous adapter
+    }
+};
+
+struct view_haystack {
+    static auto adapt(sequence_t const & haystack) noexcept {
+        return haystack | std::views::transform(std::identity{}); // searched through the generic adapter
+    }
+};
+
+template <typename matcher_t, typename haystack_tag_t>
+void adapted_haystack(benchmark::State & state, std::size_t const error_count) {
+    sequence_t const haystack = generate_sequence(state.range(0), 42);
+    sequence_t const needle = generate_sequence(32, 7);
+
+    matcher_t matcher = construct_matcher<matcher_t>(needle, error_count);
+
+    std::size_t hit_count{};
+    for (auto _ : state) {
+        matcher(haystack_tag_t::adapt(haystack), [&] (auto const &) { ++hit_count; });
+        benchmark::DoNotOptimize(hit_count);
+    }
+    set_bytes_counter(state, state.range(0));
+    state.counters["hits"] = hit_count / state.iterations();
+}
+
+template <typename pattern_spec_t>
+void seqan_string_haystack(benchmark::State & state, std::size_t const error_count) {
+    using string_t = seqan2::String<spm::dna4>;
+
+    string_t haystack{};
+    for (spm::dna4 symbol : generate_sequence(state.range(0), 42))
+        seqan2::appendValue(haystack, symbol);
+    string_t needle{};
+    for (spm::dna4 symbol : generate_sequence(32, 7))
+        seqan2::appendValue(needle, symbol);
+
+    seqan2::Pattern<string_t, pattern_spec_t> pattern{needle};
+
+    std::size_t hit_count{};
+    for (auto _ : state) {
+        seqan2::Finder<string_t> finder{haystack};
+        if constexpr (std::same_as<pattern_spec_t, seqan2::Myers<>>) {
+            while (seqan2::find(finder, pattern, -static_cast<int>(error_count)))
+                ++hit_count;
+        } else {
+            while (seqan2::find(finder, pattern))
+                ++hit_count;
+        }
+        benchmark::DoNotOptimize(hit_count);
+    }
+    set_bytes_counter(state, state.range(0));
+    state.counters["hits"] = hit_count / state.iterations();
+}
+
+using myers_t = spm::myers_matcher<std::views::all_t<sequence_t const &>>;
+using shiftor_t = spm::shiftor_matcher<std::views::all_t<sequence_t const &>>;
+
+static void myers_vector(benchmark::State & state) { adapted_haystack<myers_t, vector_haystack>(state, 3); }
+static void myers_view(benchmark::State & state) { adapted_haystack<myers_t, view_haystack>(state, 3); }
+static void myers_seqan_string(benchmark::State & state) { seqan_string_haystack<seqan2::Myers<>>(state, 3); }
+
+static void shiftor_vector(benchmark::State & state) { adapted_haystack<shiftor_t, vector_haystack>(state, 0); }
+static void shiftor_view(benchmark::State & state) { adapted_haystack<shiftor_t, view_haystack>(state, 0); }
+static void shiftor_seqan_string(benchmark::State & state) { seqan_string_haystack<seqan2::ShiftOr>(state, 0); }
+
+BENCHMARK(myers_vector)->Arg(1 << 20);
+BENCHMARK(myers_view)->Arg(1 << 20);
+BENCHMARK(myers_seqan_string)->Arg(1 << 20);
+
+BENCHMARK(shiftor_vector)->Arg(1 << 20);
+BENCHMARK(shiftor_view)->Arg(1 << 20);
+BENCHMARK(shiftor_seqan_string)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <ranges>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+
+#include "benchmark_utility.hpp"
+
+struct callback_query {
+    template <typename matcher_t>
+    static std::size_t run(matcher_t & matcher, sequence_t const & haystack) {
+        std::size_t hit_count{};
+        matcher(haystack, [&] (auto const &) { ++hit_count; });
+        return hit_count;
+    }
+};
+
+struct count_query {
+    template <typename matcher_t>
+    static std::size_t run(matcher_t & matcher, sequence_t const & haystack) {
+        return spm::count(matcher, haystack);
+    }
+};
+
+struct contains_query {
+    template <typename matcher_t>
+    static std::size_t run(matcher_t & matcher, sequence_t const & haystack) {
+        return spm::contains(matcher, haystack);
+    }
+};
+
+template <typename matcher_t, typename query_t>
+void query(benchmark::State & state, std::size_t const needle_size, std::size_t const error_count) {
+    sequence_t const haystack = generate_sequence(state.range(0), 42);
+    sequence_t const needle = generate_sequence(needle_size, 7);
+
+    matcher_t matcher = construct_matcher<matcher_t>(needle, error_count);
+
+    std::size_t result{};
+    for (auto _ : state) {
+        result += query_t::run(matcher, haystack);
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, state.range(0));
+    state.counters["result"] = result / state.iterations();
+}
+
+using myers_t = spm::myers_matcher<std::views::all_t<sequence_t const &>>;
+using shiftor_t = spm::shiftor_matcher<std::views::all_t<sequence_t const &>>;
+
+// Short needles produce many hits, such that the per-hit overhead of the callback dominates.
+static void shiftor_callback(benchmark::State & state) { query<shiftor_t, callback_query>(state, 6, 0); }
+static void shiftor_count(benchmark::State & state) { query<shiftor_t, count_query>(state, 6, 0); }
+static void shiftor_contains(benchmark::State & state) { query<shiftor_t, contains_query>(state, 24, 0); }
+
+static void myers_callback(benchmark::State & state) { query<myers_t, callback_query>(state, 12, 3); }
+static void myers_count(benchmark::State & state) { query<myers_t, count_query>(state, 12, 3); }
+static void myers_contains(benchmark::State & state) { query<myers_t, contains_query>(state, 24, 3); }
+
+BENCHMARK(shiftor_callback)->Arg(1 << 20);
+BENCHMARK(shiftor_count)->Arg(1 << 20);
+BENCHMARK(shiftor_contains)->Arg(1 << 20);
+
+BENCHMARK(myers_callback)->Arg(1 << 20);
+BENCHMARK(myers_count)->Arg(1 << 20);
+BENCHMARK(myers_contains)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
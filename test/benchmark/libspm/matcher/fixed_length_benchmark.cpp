@@ -0,0 +1,56 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <ranges>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+
+#include "benchmark_utility.hpp"
+
+template <typename matcher_t>
+void search(benchmark::State & state, std::size_t const needle_size, std::size_t const error_count) {
+    sequence_t const haystack = generate_sequence(state.range(0), 42);
+    sequence_t const needle = generate_sequence(needle_size, 7);
+
+    matcher_t const matcher{needle, error_count};
+
+    std::size_t result{};
+    for (auto _ : state) {
+        matcher_t scan_matcher = matcher; // starts every scan from the initial state.
+        scan_matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { result += hit.end_position; });
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, state.range(0));
+}
+
+using myers_t = spm::myers_matcher<std::views::all_t<sequence_t const &>>;
+
+// Read-length needles: 100 symbols need two words in the generic matcher and in the fixed-length one.
+static void myers_read(benchmark::State & state) { search<myers_t>(state, 100, 4); }
+static void fixed_length_myers_read(benchmark::State & state) {
+    search<spm::fixed_length_myers_matcher<128, spm::dna4>>(state, 100, 4);
+}
+
+static void myers_short(benchmark::State & state) { search<myers_t>(state, 24, 2); }
+static void fixed_length_myers_short(benchmark::State & state) {
+    search<spm::fixed_length_myers_matcher<32, spm::dna4>>(state, 24, 2);
+}
+
+BENCHMARK(myers_read)->Arg(1 << 20);
+BENCHMARK(fixed_length_myers_read)->Arg(1 << 20);
+
+BENCHMARK(myers_short)->Arg(1 << 20);
+BENCHMARK(fixed_length_myers_short)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,64 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/make_matcher.hpp>
+#include <libspm/matcher/matcher_cost_model.hpp>
+
+#include "benchmark_utility.hpp"
+
+using haystack_t = std::span<spm::dna4 const>;
+
+// The profile of the host in the working directory; it is written by the first run and read by the later runs.
+inline constexpr char const * profile_path = "matcher_cost_profile.txt";
+
+inline spm::matcher_cost_model const & calibrated_model() {
+    static spm::matcher_cost_model const model = [] () {
+        if (std::ifstream profile{profile_path}; profile)
+            return spm::matcher_cost_model::read_profile(profile);
+
+        spm::matcher_cost_model const calibrated = spm::calibrate_matcher_cost_model<spm::dna4>();
+        std::ofstream profile{profile_path};
+        calibrated.write_profile(profile);
+        return calibrated;
+    }();
+    return model;
+}
+
+void search(benchmark::State & state, spm::matcher_cost_model const & model) {
+    sequence_t const haystack = generate_sequence(1 << 20, 42);
+    sequence_t const needle = generate_sequence(state.range(0), 7);
+    std::size_t const error_count = state.range(1);
+
+    spm::any_matcher<haystack_t> matcher = spm::make_matcher<haystack_t>(needle,
+                                                                         error_count,
+                                                                         {.cost_model = std::addressof(model)});
+    std::size_t result{};
+    for (auto _ : state) {
+        result += spm::count(matcher, haystack_t{haystack});
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, haystack.size());
+    state.SetLabel(std::string{spm::matcher_engine_name(model.select(needle.size(), error_count, false))});
+}
+
+static void default_model(benchmark::State & state) { search(state, spm::matcher_cost_model{}); }
+static void calibrated(benchmark::State & state) { search(state, calibrated_model()); }
+
+BENCHMARK(default_model)->Args({8, 0})->Args({100, 0})->Args({24, 2})->Args({100, 4})->Args({400, 8});
+BENCHMARK(calibrated)->Args({8, 0})->Args({100, 0})->Args({24, 2})->Args({100, 4})->Args({400, 8});
+
+BENCHMARK_MAIN();
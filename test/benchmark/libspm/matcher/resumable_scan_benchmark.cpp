@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/resumable_scan.hpp>
+
+#include "benchmark_utility.hpp"
+
+using matcher_t = spm::fixed_length_myers_matcher<64, spm::dna4>;
+
+inline constexpr std::size_t haystack_size = 1 << 26;
+
+static void plain_scan(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(haystack_size, 42);
+    matcher_t const matcher{generate_sequence(50, 7), 4};
+
+    std::size_t result{};
+    for (auto _ : state) {
+        matcher_t scan_matcher = matcher;
+        scan_matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { result += hit.end_position; });
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, haystack_size);
+}
+
+// Writes a checkpoint file every `state.range(0)` symbols.
+static void resumable(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(haystack_size, 42);
+    matcher_t const matcher{generate_sequence(50, 7), 4};
+    std::filesystem::path const checkpoint_path = std::filesystem::temp_directory_path() /
+                                                  "libspm_resumable_scan_benchmark.ckpt";
+
+    std::size_t result{};
+    for (auto _ : state) {
+        std::filesystem::remove(checkpoint_path);
+        spm::resumable_scan scan{matcher, checkpoint_path, static_cast<std::size_t>(state.range(0))};
+        scan(haystack, [&] (spm::matcher_hit const & hit) { result += hit.end_position; });
+        benchmark::DoNotOptimize(result);
+    }
+    std::filesystem::remove(checkpoint_path);
+    set_bytes_counter(state, haystack_size);
+}
+
+BENCHMARK(plain_scan)->Unit(benchmark::kMillisecond);
+BENCHMARK(resumable)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <ranges>
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/concept.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/shiftor_matcher.hpp>
+
+#include "benchmark_utility.hpp"
+
+struct callback_search {
+    template <typename matcher_t>
+    static std::size_t run(matcher_t & matcher, sequence_t const & haystack) {
+        std::size_t checksum{};
+        matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { checksum += hit.end_position; });
+        return checksum;
+    }
+};
+
+struct pull_search {
+    template <typename matcher_t>
+    static std::size_t run(matcher_t & matcher, sequence_t const & haystack) {
+        std::size_t checksum{};
+        for (spm::matcher_hit const & hit : spm::search(matcher, haystack))
+            checksum += hit.end_position;
+        return checksum;
+    }
+};
+
+template <typename matcher_t, typename search_t>
+void search(benchmark::State & state, std::size_t const needle_size, std::size_t const error_count) {
+    sequence_t const haystack = generate_sequence(state.range(0), 42);
+    sequence_t const needle = generate_sequence(needle_size, 7);
+
+    matcher_t matcher = construct_matcher<matcher_t>(needle, error_count);
+
+    std::size_t result{};
+    for (auto _ : state) {
+        result += search_t::run(matcher, haystack);
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, state.range(0));
+}
+
+using myers_t = spm::myers_matcher<std::views::all_t<sequence_t const &>>;
+using shiftor_t = spm::shiftor_matcher<std::views::all_t<sequence_t const &>>;
+
+// Short needles produce many hits, such that the cost of suspending and resuming the search per hit dominates.
+static void shiftor_callback(benchmark::State & state) { search<shiftor_t, callback_search>(state, 6, 0); }
+static void shiftor_pull(benchmark::State & state) { search<shiftor_t, pull_search>(state, 6, 0); }
+
+static void myers_callback(benchmark::State & state) { search<myers_t, callback_search>(state, 12, 3); }
+static void myers_pull(benchmark::State & state) { search<myers_t, pull_search>(state, 12, 3); }
+
+BENCHMARK(shiftor_callback)->Arg(1 << 20);
+BENCHMARK(shiftor_pull)->Arg(1 << 20);
+
+BENCHMARK(myers_callback)->Arg(1 << 20);
+BENCHMARK(myers_pull)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/fixed_length_matcher.hpp>
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/tiled_search.hpp>
+
+#include "benchmark_utility.hpp"
+
+using matcher_t = spm::fixed_length_myers_matcher<32, spm::dna4>;
+
+inline std::vector<matcher_t> generate_matchers(std::size_t const matcher_count) {
+    std::vector<matcher_t> matchers{};
+    for (std::size_t index = 0; index < matcher_count; ++index)
+        matchers.emplace_back(generate_sequence(24, 100 + index), 2);
+    return matchers;
+}
+
+// The haystack exceeds the last level cache, such that full scans stream it from memory per matcher.
+inline constexpr std::size_t haystack_size = 1 << 28;
+
+// The haystack bytes read by all matchers per second.
+inline void set_bandwidth(benchmark::State & state, std::size_t const matcher_count) {
+    state.counters["bandwidth"] = benchmark::Counter(static_cast<double>(haystack_size * sizeof(spm::dna4) *
+                                                                         matcher_count),
+                                                     benchmark::Counter::kIsIterationInvariantRate,
+                                                     benchmark::Counter::kIs1024);
+}
+
+static void full_scans(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(haystack_size, 42);
+    std::vector<matcher_t> const matchers = generate_matchers(state.range(0));
+
+    std::size_t result{};
+    for (auto _ : state) {
+        for (matcher_t matcher : matchers)
+            matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { result += hit.end_position; });
+        benchmark::DoNotOptimize(result);
+    }
+    set_bandwidth(state, matchers.size());
+}
+
+static void tiled(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(haystack_size, 42);
+    std::vector<matcher_t> const matchers = generate_matchers(state.range(0));
+
+    std::size_t result{};
+    for (auto _ : state) {
+        spm::tiled_search(matchers, haystack, [&] (std::size_t, spm::matcher_hit const & hit) {
+            result += hit.end_position;
+        }, state.range(1), 1);
+        benchmark::DoNotOptimize(result);
+    }
+    set_bandwidth(state, matchers.size());
+}
+
+BENCHMARK(full_scans)->Arg(16)->Unit(benchmark::kMillisecond);
+BENCHMARK(tiled)->Args({16, 64 * 1024})->Args({16, 256 * 1024})->Args({16, 1024 * 1024})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
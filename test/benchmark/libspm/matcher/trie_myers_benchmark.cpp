@@ -0,0 +1,64 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <libspm/seqan/alphabet.hpp>
+
+#include <libspm/matcher/matcher_hit.hpp>
+#include <libspm/matcher/myers_matcher.hpp>
+#include <libspm/matcher/trie_myers_matcher.hpp>
+
+#include "benchmark_utility.hpp"
+
+// An amplicon panel: every needle starts with one of a few primers followed by an individual insert.
+inline std::vector<sequence_t> generate_panel(std::size_t const needle_count) {
+    std::vector<sequence_t> const primers{generate_sequence(20, 1), generate_sequence(20, 2)};
+    std::vector<sequence_t> needles{};
+    for (std::size_t index = 0; index < needle_count; ++index) {
+        sequence_t needle = primers[index % primers.size()];
+        sequence_t const insert = generate_sequence(30, 100 + index);
+        needle.insert(needle.end(), insert.begin(), insert.end());
+        needles.push_back(std::move(needle));
+    }
+    return needles;
+}
+
+static void separate_myers(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(1 << 18, 42);
+    std::vector<sequence_t> const needles = generate_panel(state.range(0));
+
+    std::size_t result{};
+    for (auto _ : state) {
+        for (sequence_t const & needle : needles) {
+            spm::myers_matcher matcher{needle, 3u};
+            matcher(haystack, 0, [&] (spm::matcher_hit const & hit) { result += hit.end_position; });
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, haystack.size());
+}
+
+static void trie_myers(benchmark::State & state) {
+    sequence_t const haystack = generate_sequence(1 << 18, 42);
+    std::vector<sequence_t> const needles = generate_panel(state.range(0));
+
+    std::size_t result{};
+    for (auto _ : state) {
+        spm::trie_myers_matcher matcher{needles, 3u};
+        matcher(haystack, 0, [&] (spm::needle_hit const & hit) { result += hit.end_position; });
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes_counter(state, haystack.size());
+}
+
+BENCHMARK(separate_myers)->Arg(16)->Arg(64);
+BENCHMARK(trie_myers)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();